@@ -0,0 +1,57 @@
+// getMSTForest algorithms on a random sparse undirected graph.
+// usage: bench_mst [num_vertexs] [num_edges]
+#include "graph_mst.hpp"
+#include "parallel.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace gt = graphTest;
+
+template <typename Fn> double seconds(Fn &&fn) {
+  auto begin = std::chrono::steady_clock::now();
+  fn();
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - begin;
+  return d.count();
+}
+
+int main(int argc, char **argv) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+  const size_t m = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8 * n;
+
+  std::vector<int> data(n);
+  gt::UnDirectedGraph<int> g;
+  for (size_t i = 0; i < n; ++i) {
+    data[i] = static_cast<int>(i);
+    g.addVertex(&data[i]);
+  }
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<size_t> pick(0, n - 1);
+  std::uniform_int_distribution<int> weight(1, 1000000);
+  for (size_t i = 0; i < m; ++i) {
+    const size_t u = pick(rng), v = pick(rng);
+    if (u != v) {
+      g.addEdge(&data[u], &data[v], weight(rng));
+    }
+  }
+  std::cout << "vertexs " << n << ", edges " << m << "\n";
+
+  auto run = [&](const char *name, gt::MSTAlgo algo, size_t threads) {
+    gt::SpanningForest<int> forest;
+    const double t =
+        seconds([&]() { forest = gt::getMSTForest<int>(&g, algo, threads); });
+    std::cout << name << " " << threads << " thread(s): " << t
+              << " s, weight " << forest.weight << "\n";
+  };
+  run("KRUSKAL        ", gt::KRUSKAL, 1);
+  run("FILTER_KRUSKAL ", gt::FILTER_KRUSKAL, 1);
+  run("PRIM           ", gt::PRIM, 1);
+  const size_t max_threads = gt::defaultThreadCount();
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    run("BORUVKA        ", gt::BORUVKA, threads);
+    run("BORUVKA_KRUSKAL", gt::BORUVKA_KRUSKAL, threads);
+  }
+  return 0;
+}
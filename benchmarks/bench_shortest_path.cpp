@@ -0,0 +1,134 @@
+// Single-source shortest path algorithms on a random sparse digraph with
+// non-negative weights and on a grid (high diameter, so many small
+// delta-stepping phases), then all-pairs algorithms on a smaller digraph.
+// usage: bench_shortest_path [num_vertexs] [num_edges] [max_weight]
+//                            [apsp_vertexs] [grid_side]
+#include "graph_shartest_path.hpp"
+#include "parallel.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace gt = graphTest;
+
+template <typename Fn> double seconds(Fn &&fn) {
+  auto begin = std::chrono::steady_clock::now();
+  fn();
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - begin;
+  return d.count();
+}
+
+int main(int argc, char **argv) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+  const size_t m = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8 * n;
+  const int max_weight = argc > 3 ? std::atoi(argv[3]) : 1000;
+  const size_t apsp_n = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 2000;
+  const size_t side = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 300;
+
+  std::vector<int> data(n);
+  gt::DirectedGraph<int> g;
+  for (size_t i = 0; i < n; ++i) {
+    data[i] = static_cast<int>(i);
+    g.addVertex(&data[i]);
+  }
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<size_t> pick(0, n - 1);
+  std::uniform_int_distribution<int> weight(0, max_weight);
+  for (size_t i = 0; i < m; ++i) {
+    g.addEdge(&data[pick(rng)], &data[pick(rng)], weight(rng));
+  }
+  std::cout << "vertexs " << n << ", edges " << m << ", max weight "
+            << max_weight << "\n";
+
+  auto run = [&](const char *name, gt::ShortestPathAlgo algo, size_t threads) {
+    size_t tree_edges = 0;
+    const double t = seconds([&]() {
+      tree_edges =
+          gt::ShortestPathOneSource(&g, &data[0], algo, threads).size();
+    });
+    std::cout << name << " " << threads << " thread(s): " << t
+              << " s, tree edges " << tree_edges << "\n";
+  };
+  run("DIJKSTRA      ", gt::DIJKSTRA, 1);
+  run("DIJKSTRA_RADIX", gt::DIJKSTRA_RADIX, 1);
+  run("SPFA          ", gt::SPFA, 1);
+  const size_t max_threads = gt::defaultThreadCount();
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    run("DELTA_STEPPING", gt::DELTA_STEPPING, threads);
+    run("BELLMAN_FORD_P", gt::BELLMAN_FORD_PARALLEL, threads);
+  }
+
+  gt::DirectedGraph<int> grid;
+  std::vector<int> cells(side * side);
+  for (size_t i = 0; i < cells.size(); ++i) {
+    cells[i] = static_cast<int>(i);
+    grid.addVertex(&cells[i]);
+  }
+  for (size_t r = 0; r < side; ++r) {
+    for (size_t c = 0; c < side; ++c) {
+      int *u = &cells[r * side + c];
+      if (c + 1 < side) {
+        grid.addEdge(u, u + 1, weight(rng));
+        grid.addEdge(u + 1, u, weight(rng));
+      }
+      if (r + 1 < side) {
+        grid.addEdge(u, u + side, weight(rng));
+        grid.addEdge(u + side, u, weight(rng));
+      }
+    }
+  }
+  std::cout << "grid " << side << " x " << side << "\n";
+  auto runGrid = [&](const char *name, gt::ShortestPathAlgo algo,
+                     size_t threads) {
+    size_t tree_edges = 0;
+    const double t = seconds([&]() {
+      tree_edges =
+          gt::ShortestPathOneSource(&grid, &cells[0], algo, threads).size();
+    });
+    std::cout << name << " " << threads << " thread(s): " << t
+              << " s, tree edges " << tree_edges << "\n";
+  };
+  runGrid("DIJKSTRA_RADIX", gt::DIJKSTRA_RADIX, 1);
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    runGrid("DELTA_STEPPING", gt::DELTA_STEPPING, threads);
+  }
+
+  const int queries = 100;
+  size_t settled = 0;
+  const double t = seconds([&]() {
+    for (int i = 0; i < queries; ++i) {
+      settled +=
+          gt::ShortestPath(&g, &data[pick(rng)], &data[pick(rng)]).settled;
+    }
+  });
+  std::cout << "ShortestPath   " << queries << " s-t queries: " << t
+            << " s, settled " << settled / queries << " per query\n";
+
+  gt::DirectedGraph<int> small;
+  for (size_t i = 0; i < apsp_n; ++i) {
+    small.addVertex(&data[i]);
+  }
+  std::uniform_int_distribution<size_t> pick_small(0, apsp_n - 1);
+  for (size_t i = 0; i < 8 * apsp_n; ++i) {
+    small.addEdge(&data[pick_small(rng)], &data[pick_small(rng)],
+                  weight(rng));
+  }
+  std::cout << "all pairs: vertexs " << apsp_n << ", edges " << 8 * apsp_n
+            << "\n";
+  auto runAll = [&](const char *name, gt::ShortestPathAlgo algo,
+                    size_t threads) {
+    size_t trees = 0;
+    const double t = seconds([&]() {
+      trees = gt::ShortestPathAllPairs(&small, algo, threads).size();
+    });
+    std::cout << name << " " << threads << " thread(s): " << t
+              << " s, trees " << trees << "\n";
+  };
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    runAll("FLOYD_WARSHALL", gt::FLOYD_WARSHALL, threads);
+    runAll("JOHNSON       ", gt::JOHNSON, threads);
+  }
+  return 0;
+}
@@ -0,0 +1,57 @@
+// DisjointSets vs ConcurrentDisjointSets on random merges.
+// usage: bench_union_find [num_elements] [num_merges]
+#include "basicAlgo.hpp"
+#include "parallel.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace gt = graphTest;
+
+template <typename Fn> double seconds(Fn &&fn) {
+  auto begin = std::chrono::steady_clock::now();
+  fn();
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - begin;
+  return d.count();
+}
+
+int main(int argc, char **argv) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  const size_t m = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4 * n;
+
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<int> pick(0, static_cast<int>(n) - 1);
+  std::vector<std::pair<int, int>> pairs(m);
+  for (auto &p : pairs) {
+    p = {pick(rng), pick(rng)};
+  }
+
+  gt::DisjointSets serial(n);
+  const double serial_time = seconds([&]() {
+    for (const auto &p : pairs) {
+      serial.merge(p.first, p.second);
+    }
+  });
+  std::cout << "elements " << n << ", merges " << m << "\n";
+  std::cout << "DisjointSets            1 thread : " << serial_time
+            << " s, sets " << serial.numSets() << "\n";
+
+  const size_t max_threads = gt::defaultThreadCount();
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    gt::ConcurrentDisjointSets sets(n);
+    const double t = seconds([&]() {
+      gt::parallelForBlocks(m, threads, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          sets.merge(pairs[i].first, pairs[i].second);
+        }
+      });
+    });
+    std::cout << "ConcurrentDisjointSets " << threads
+              << " thread(s): " << t << " s, speedup " << serial_time / t
+              << ", sets " << sets.countSets() << "\n";
+  }
+  return 0;
+}
@@ -1,5 +1,9 @@
 #pragma once
+#include "generator.hpp"
 #include "graph.hpp"
+#include "traversal_workspace.hpp"
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -7,6 +11,7 @@
 #include <stack>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 namespace graphTest {
 
@@ -123,73 +128,535 @@ std::vector<T *> BFS(const std::vector<T *> &starts,
   }
   return order;
 }
-template <typename DataT> class UnionFind {
+// Lazy counterparts of DFS/BFS. Vertexs are produced on demand by a
+// coroutine in the same order DFS/BFS report them, and no `order` vector is
+// built, so a caller can stop after a prefix or interleave traversals.
+// Arguments are taken by value because the coroutine outlives the call.
+template <typename T>
+Generator<T *> DFSLazy(std::vector<T *> starts,
+                       std::function<std::vector<T *>(T *)> getNexts,
+                       bool postorder = false) {
+  std::unordered_set<T *> visited;
+  std::unordered_set<T *> finished;
+  std::vector<T *> stk;
+  for (auto start : starts) {
+    if (start != nullptr) {
+      stk.push_back(start);
+    }
+  }
+
+  while (!stk.empty()) {
+    T *curr = stk.back();
+    if (visited.count(curr) == 0) {
+      visited.insert(curr);
+      if (!postorder) {
+        co_yield curr;
+      }
+      std::vector<T *> nexts = getNexts(curr);
+      for (auto it = nexts.rbegin(); it != nexts.rend(); ++it) {
+        if (*it != nullptr && visited.count(*it) == 0) {
+          stk.push_back(*it);
+        }
+      }
+    } else if (finished.count(curr) == 0) {
+      // every child pushed above curr has been popped, so curr is finished
+      stk.pop_back();
+      finished.insert(curr);
+      if (postorder) {
+        co_yield curr;
+      }
+    } else {
+      stk.pop_back();
+    }
+  }
+}
+
+template <typename T>
+Generator<T *> BFSLazy(std::vector<T *> starts,
+                       std::function<std::vector<T *>(T *)> getNexts) {
+  std::unordered_set<T *> visited;
+  std::queue<T *> q;
+  for (auto start : starts) {
+    if (start != nullptr && visited.count(start) == 0) {
+      q.push(start);
+      visited.insert(start);
+    }
+  }
+
+  while (!q.empty()) {
+    T *curr = q.front();
+    q.pop();
+    co_yield curr;
+    for (auto &next : getNexts(curr)) {
+      if (next != nullptr && visited.count(next) == 0) {
+        q.push(next);
+        visited.insert(next);
+      }
+    }
+  }
+}
+
+// DFS/BFS variants that keep their visited marks and stacks in a
+// TraversalWorkspace bound to the graph getNexts walks on. Vertexs that are
+// not part of the workspace graph are ignored.
+template <typename T>
+std::vector<T *> DFS(const std::vector<T *> &starts,
+                     const std::function<std::vector<T *>(T *)> &getNexts,
+                     TraversalWorkspace<T> &ws,
+                     const std::function<void(T *)> &preVisit = nullptr,
+                     const std::function<void(T *)> &postVisit = nullptr) {
+  if (starts.empty())
+    return {};
+  const auto &cg = ws.graph();
+  std::vector<T *> order;
+  std::vector<int> &stk = ws.stack();
+  stk.clear();
+  ws.newEpoch();
+  // state: 0 unvisited, 1 visited, 2 finished
+  for (auto start : starts) {
+    const int id = start == nullptr ? -1 : cg.indexOf(start);
+    if (id >= 0) {
+      stk.push_back(id);
+    }
+  }
+
+  while (!stk.empty()) {
+    const int curr = stk.back();
+    T *data = cg.vertexAt(curr);
+    const int state = ws.state(curr);
+    if (state == 0) {
+      ws.setState(curr, 1);
+      order.push_back(data);
+      if (preVisit) {
+        preVisit(data);
+      }
+      std::vector<T *> nexts = getNexts(data);
+      for (auto it = nexts.rbegin(); it != nexts.rend(); ++it) {
+        const int id = *it == nullptr ? -1 : cg.indexOf(*it);
+        if (id >= 0 && ws.state(id) == 0) {
+          stk.push_back(id);
+        }
+      }
+    } else if (state == 1) {
+      // every child pushed above curr has been popped, so curr is finished
+      stk.pop_back();
+      ws.setState(curr, 2);
+      if (postVisit) {
+        postVisit(data);
+      }
+    } else {
+      stk.pop_back();
+    }
+  }
+  return order;
+}
+
+template <typename T>
+std::vector<T *> BFS(const std::vector<T *> &starts,
+                     const std::function<std::vector<T *>(T *)> &getNexts,
+                     TraversalWorkspace<T> &ws,
+                     const std::function<void(T *)> &preVisit = nullptr,
+                     const std::function<void(T *)> &postVisit = nullptr) {
+  if (starts.empty())
+    return {};
+  const auto &cg = ws.graph();
+  std::vector<T *> order;
+  std::vector<int> &q = ws.queue();
+  q.clear();
+  ws.newEpoch();
+  for (auto start : starts) {
+    const int id = start == nullptr ? -1 : cg.indexOf(start);
+    if (id >= 0 && ws.state(id) == 0) {
+      q.push_back(id);
+      ws.setState(id, 1);
+    }
+  }
+
+  for (size_t head = 0; head < q.size(); ++head) {
+    T *curr = cg.vertexAt(q[head]);
+    order.emplace_back(curr);
+    if (preVisit) {
+      preVisit(curr);
+    }
+    std::vector<T *> nexts = getNexts(curr);
+    for (auto &next : nexts) {
+      const int id = next == nullptr ? -1 : cg.indexOf(next);
+      if (id >= 0 && ws.state(id) == 0) {
+        q.push_back(id);
+        ws.setState(id, 1);
+      }
+    }
+  }
+
+  if (postVisit) {
+    for (int i = order.size() - 1; i >= 0; i--) {
+      postVisit(order[i]);
+    }
+  }
+  return order;
+}
+
+// Index-based disjoint sets over the elements 0..size()-1, stored in flat
+// vectors. Union by size keeps the trees shallow and find() halves paths
+// iteratively, so long chains can not overflow the stack.
+class DisjointSets {
 public:
-  UnionFind() = default;
-  void add(DataT *data) {
-    if (id_map_.find(data) != id_map_.end()) {
-      return;
+  DisjointSets() = default;
+  explicit DisjointSets(size_t n) { reset(n); }
+
+  // n singleton sets
+  void reset(size_t n) {
+    parent_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      parent_[i] = static_cast<int>(i);
     }
-    int id = parent_.size();
-    id_map_[data] = id;
-    reverse_id_map_[id] = data;
+    size_.assign(n, 1);
+    num_sets_ = n;
+  }
+
+  void reserve(size_t n) {
+    parent_.reserve(n);
+    size_.reserve(n);
+  }
+
+  // appends a singleton set and returns its element
+  int add() {
+    const int id = static_cast<int>(parent_.size());
     parent_.push_back(id);
+    size_.push_back(1);
+    ++num_sets_;
+    return id;
   }
 
-  void merge(DataT *data1, DataT *data2) {
-    if (data1 == nullptr || data2 == nullptr) {
-      return;
+  int find(int x) {
+    while (parent_[x] != x) {
+      parent_[x] = parent_[parent_[x]];
+      x = parent_[x];
     }
-    if (id_map_.find(data1) == id_map_.end() ||
-        id_map_.find(data2) == id_map_.end()) {
+    return x;
+  }
+
+  // false if a and b were already in the same set
+  bool merge(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+      return false;
+    }
+    if (size_[a] < size_[b]) {
+      std::swap(a, b);
+    }
+    parent_[b] = a;
+    size_[a] += size_[b];
+    --num_sets_;
+    return true;
+  }
+
+  bool same(int a, int b) { return find(a) == find(b); }
+  int setSize(int x) { return size_[find(x)]; }
+  size_t size() const { return parent_.size(); }
+  size_t numSets() const { return num_sets_; }
+
+  // Groups the elements with a counting pass: the members of group g are
+  // members[offsets[g]] .. members[offsets[g + 1] - 1], in increasing order.
+  // Groups are numbered by their smallest element.
+  void getGroups(std::vector<int> &offsets, std::vector<int> &members) {
+    const int n = static_cast<int>(parent_.size());
+    std::vector<int> group_of_root(n, -1);
+    std::vector<int> group(n);
+    offsets.assign(1, 0);
+    for (int i = 0; i < n; ++i) {
+      const int root = find(i);
+      if (group_of_root[root] == -1) {
+        group_of_root[root] = static_cast<int>(offsets.size()) - 1;
+        offsets.push_back(0);
+      }
+      group[i] = group_of_root[root];
+      ++offsets[group[i] + 1];
+    }
+    for (size_t g = 1; g < offsets.size(); ++g) {
+      offsets[g] += offsets[g - 1];
+    }
+    members.resize(n);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < n; ++i) {
+      members[fill[group[i]]++] = i;
+    }
+  }
+
+private:
+  std::vector<int> parent_;
+  std::vector<int> size_;
+  size_t num_sets_ = 0;
+};
+
+// Pointer front-end of DisjointSets. Each added vertex gets a dense id in
+// insertion order; unknown or null pointers are ignored.
+template <typename DataT> class UnionFind {
+public:
+  UnionFind() = default;
+
+  void reserve(size_t n) {
+    id_map_.reserve(n);
+    data_.reserve(n);
+    sets_.reserve(n);
+  }
+
+  void add(DataT *data) {
+    if (data == nullptr || id_map_.count(data) != 0) {
       return;
     }
-    int id1 = id_map_[data1];
-    int id2 = id_map_[data2];
-    int parent1 = findParent(id1);
-    int parent2 = findParent(id2);
-    if (parent1 != parent2) {
-      parent_[parent1] = parent2;
+    id_map_[data] = sets_.add();
+    data_.push_back(data);
+  }
+
+  // false if nothing was merged (same group, or unknown vertex)
+  bool merge(DataT *data1, DataT *data2) {
+    const int id1 = indexOf(data1);
+    const int id2 = indexOf(data2);
+    if (id1 < 0 || id2 < 0) {
+      return false;
     }
+    return sets_.merge(id1, id2);
   }
 
   DataT *findParent(DataT *data) {
-    if (data == nullptr) {
+    const int id = indexOf(data);
+    if (id < 0) {
       return nullptr;
     }
-    if (id_map_.find(data) == id_map_.end()) {
-      return nullptr;
+    return data_[sets_.find(id)];
+  }
+
+  bool same(DataT *data1, DataT *data2) {
+    const int id1 = indexOf(data1);
+    const int id2 = indexOf(data2);
+    return id1 >= 0 && id2 >= 0 && sets_.same(id1, id2);
+  }
+
+  // size of the group containing data, 0 for an unknown vertex
+  int groupSize(DataT *data) {
+    const int id = indexOf(data);
+    return id < 0 ? 0 : sets_.setSize(id);
+  }
+
+  size_t size() const { return data_.size(); }
+  size_t numGroups() const { return sets_.numSets(); }
+
+  // dense id given by add(), or -1
+  int indexOf(DataT *data) const {
+    auto it = id_map_.find(data);
+    return it == id_map_.end() ? -1 : it->second;
+  }
+  DataT *dataAt(int id) const { return data_[id]; }
+  DisjointSets &sets() { return sets_; }
+
+  // (representative, members) per group, ordered by the first added member
+  std::vector<std::pair<DataT *, std::vector<DataT *>>> getGroups() {
+    std::vector<int> offsets;
+    std::vector<int> members;
+    sets_.getGroups(offsets, members);
+    std::vector<std::pair<DataT *, std::vector<DataT *>>> groups(
+        offsets.size() - 1);
+    for (size_t g = 0; g + 1 < offsets.size(); ++g) {
+      auto &group = groups[g];
+      group.first = data_[sets_.find(members[offsets[g]])];
+      group.second.reserve(offsets[g + 1] - offsets[g]);
+      for (int i = offsets[g]; i < offsets[g + 1]; ++i) {
+        group.second.push_back(data_[members[i]]);
+      }
+    }
+    return groups;
+  }
+
+private:
+  std::unordered_map<DataT *, int> id_map_;
+  std::vector<DataT *> data_;
+  DisjointSets sets_;
+};
+
+// Disjoint sets that many threads may merge() and find() at the same time
+// without locks (Anderson-Woll style). A root is linked below the other
+// root with a CAS, always the larger index below the smaller one, so no
+// cycle can form; find() does path splitting with CAS as well. The number
+// of elements is fixed at construction.
+class ConcurrentDisjointSets {
+public:
+  ConcurrentDisjointSets() = default;
+  explicit ConcurrentDisjointSets(size_t n) { reset(n); }
+
+  // n singleton sets, not thread safe
+  void reset(size_t n) {
+    parent_ = std::vector<std::atomic<int>>(n);
+    for (size_t i = 0; i < n; ++i) {
+      parent_[i].store(static_cast<int>(i), std::memory_order_relaxed);
     }
-    int id = id_map_[data];
-    int parent_id = findParent(id);
-    if (reverse_id_map_.find(parent_id) != reverse_id_map_.end()) {
-      return reverse_id_map_[parent_id];
+  }
+
+  int find(int x) {
+    while (true) {
+      int p = parent_[x].load(std::memory_order_relaxed);
+      if (p == x) {
+        return x;
+      }
+      const int gp = parent_[p].load(std::memory_order_relaxed);
+      if (p != gp) {
+        // another thread may have changed parent_[x] already, which is fine
+        parent_[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+      }
+      x = p;
     }
-    return nullptr;
   }
 
-  std::unordered_map<DataT *, std::vector<DataT *>> getGroups() {
-    std::unordered_map<DataT *, std::vector<DataT *>> groups;
-    for (const auto &pair : id_map_) {
-      DataT *data = pair.first;
-      DataT *parent_data = findParent(data);
-      if (parent_data != nullptr) {
-        groups[parent_data].push_back(data);
+  // false if a and b were already in the same set
+  bool merge(int a, int b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return false;
+      }
+      if (a < b) {
+        std::swap(a, b);
       }
+      int expected = a;
+      if (parent_[a].compare_exchange_strong(expected, b,
+                                             std::memory_order_acq_rel)) {
+        return true;
+      }
+      // a stopped being a root in the meantime, retry from the new roots
     }
-    return groups;
+  }
+
+  bool same(int a, int b) {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return true;
+      }
+      // a still being a root after b's find means they were disjoint
+      if (parent_[a].load(std::memory_order_acquire) == a) {
+        return false;
+      }
+    }
+  }
+
+  size_t size() const { return parent_.size(); }
+
+  // not thread safe, call after the concurrent phase
+  size_t countSets() const {
+    size_t count = 0;
+    for (size_t i = 0; i < parent_.size(); ++i) {
+      if (parent_[i].load(std::memory_order_relaxed) == static_cast<int>(i)) {
+        ++count;
+      }
+    }
+    return count;
+  }
+
+private:
+  std::vector<std::atomic<int>> parent_;
+};
+
+// Indexed d-ary min-heap over the ids 0..capacity-1. Each id is in the heap
+// at most once and its key can be lowered in place, so the heap never holds
+// more than capacity entries. Ties between equal keys are broken by id.
+template <typename KeyT, int D = 4> class IndexedHeap {
+public:
+  IndexedHeap() = default;
+  explicit IndexedHeap(size_t capacity) { reset(capacity); }
+
+  // empties the heap and allows ids below capacity
+  void reset(size_t capacity) {
+    heap_.clear();
+    key_.resize(capacity);
+    pos_.assign(capacity, -1);
+  }
+
+  bool empty() const { return heap_.empty(); }
+  size_t size() const { return heap_.size(); }
+  bool contains(int id) const { return pos_[id] >= 0; }
+  int top() const { return heap_[0]; }
+  const KeyT &key(int id) const { return key_[id]; }
+
+  // inserts id, or lowers its key; returns false if the key did not drop
+  bool pushOrDecrease(int id, const KeyT &key) {
+    if (pos_[id] < 0) {
+      key_[id] = key;
+      pos_[id] = static_cast<int>(heap_.size());
+      heap_.push_back(id);
+    } else if (key < key_[id]) {
+      key_[id] = key;
+    } else {
+      return false;
+    }
+    siftUp(pos_[id]);
+    return true;
+  }
+
+  int pop() {
+    const int id = heap_[0];
+    pos_[id] = -1;
+    const int last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      heap_[0] = last;
+      pos_[last] = 0;
+      siftDown(0);
+    }
+    return id;
   }
 
 private:
-  int findParent(int id) {
-    if (parent_[id] != id) {
-      parent_[id] = findParent(parent_[id]);
+  bool before(int a, int b) const {
+    return key_[a] < key_[b] || (!(key_[b] < key_[a]) && a < b);
+  }
+
+  void siftUp(int i) {
+    const int id = heap_[i];
+    while (i > 0) {
+      const int parent = (i - 1) / D;
+      if (!before(id, heap_[parent])) {
+        break;
+      }
+      heap_[i] = heap_[parent];
+      pos_[heap_[i]] = i;
+      i = parent;
     }
-    return parent_[id];
+    heap_[i] = id;
+    pos_[id] = i;
   }
-  std::unordered_map<DataT *, int> id_map_;
-  std::unordered_map<int, DataT *> reverse_id_map_;
-  std::vector<int> parent_;
+
+  void siftDown(int i) {
+    const int n = static_cast<int>(heap_.size());
+    const int id = heap_[i];
+    while (true) {
+      const int first = i * D + 1;
+      if (first >= n) {
+        break;
+      }
+      int best = first;
+      const int end = std::min(first + D, n);
+      for (int c = first + 1; c < end; ++c) {
+        if (before(heap_[c], heap_[best])) {
+          best = c;
+        }
+      }
+      if (!before(heap_[best], id)) {
+        break;
+      }
+      heap_[i] = heap_[best];
+      pos_[heap_[i]] = i;
+      i = best;
+    }
+    heap_[i] = id;
+    pos_[id] = i;
+  }
+
+  std::vector<int> heap_;
+  std::vector<KeyT> key_;
+  std::vector<int> pos_;
 };
 
 template <typename T> std::unique_ptr<Graph<T>> CloneGraph(Graph<T> *g) {
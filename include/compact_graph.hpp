@@ -0,0 +1,133 @@
+#pragma once
+#include "graph.hpp"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace graphTest {
+
+// Read-only dense snapshot of a Graph<T>.
+// Vertices are renumbered 0..n-1 in getAllVertexs() order and both out-arcs
+// and in-arcs are stored in CSR form, so algorithms that run many times on
+// the same graph can work on flat arrays instead of pointer-keyed maps.
+// An undirected graph keeps both directions of every edge as arcs.
+// The snapshot does not track later changes of the source graph; call
+// build() again after modifying it.
+template <typename DataT> class CompactGraph {
+public:
+  typedef typename Graph<DataT>::Pointer Pointer;
+  typedef typename Graph<DataT>::Vertex Vertex;
+  typedef typename Graph<DataT>::Edge Edge;
+
+  CompactGraph() = default;
+  explicit CompactGraph(const Graph<DataT> *g) { build(g); }
+
+  void build(const Graph<DataT> *g) {
+    vertexs_.clear();
+    index_of_.clear();
+    out_offsets_.assign(1, 0);
+    out_targets_.clear();
+    out_weights_.clear();
+    in_offsets_.assign(1, 0);
+    in_sources_.clear();
+    in_weights_.clear();
+    directed_ = true;
+    has_negative_weight_ = false;
+    if (g == nullptr) {
+      return;
+    }
+    directed_ = g->isDirected();
+    vertexs_ = g->getAllVertexs();
+    const size_t n = vertexs_.size();
+    index_of_.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      index_of_[vertexs_[i]] = static_cast<int>(i);
+    }
+
+    out_offsets_.assign(n + 1, 0);
+    in_offsets_.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+      out_offsets_[i + 1] = out_offsets_[i] + g->getOutdegrees(vertexs_[i]);
+      in_offsets_[i + 1] = in_offsets_[i] + g->getIndegrees(vertexs_[i]);
+    }
+    out_targets_.resize(out_offsets_[n]);
+    out_weights_.resize(out_offsets_[n]);
+    in_sources_.resize(in_offsets_[n]);
+    in_weights_.resize(in_offsets_[n]);
+
+    std::vector<Edge> edges;
+    for (size_t i = 0; i < n; ++i) {
+      g->getOutEdges(vertexs_[i], edges);
+      size_t pos = out_offsets_[i];
+      for (const auto &e : edges) {
+        out_targets_[pos] = index_of_.at(e.to.get_data());
+        out_weights_[pos] = e.weight_;
+        if (e.weight_ < 0) {
+          has_negative_weight_ = true;
+        }
+        ++pos;
+      }
+      g->getInEdges(vertexs_[i], edges);
+      pos = in_offsets_[i];
+      for (const auto &e : edges) {
+        in_sources_[pos] = index_of_.at(e.from.get_data());
+        in_weights_[pos] = e.weight_;
+        ++pos;
+      }
+    }
+  }
+
+  bool isDirected() const { return directed_; }
+  size_t numVertexs() const { return vertexs_.size(); }
+  // number of stored arcs, an undirected edge counts twice
+  size_t numArcs() const { return out_targets_.size(); }
+  bool hasNegativeWeight() const { return has_negative_weight_; }
+
+  // returns -1 if data is not a vertex of the snapshot
+  int indexOf(Pointer data) const {
+    auto it = index_of_.find(data);
+    return it == index_of_.end() ? -1 : it->second;
+  }
+  Pointer vertexAt(int id) const { return vertexs_[id]; }
+  const std::vector<Pointer> &vertexs() const { return vertexs_; }
+
+  // out-arcs of u are [outBegin(u), outEnd(u)) in outTargets()/outWeights()
+  size_t outBegin(int u) const { return out_offsets_[u]; }
+  size_t outEnd(int u) const { return out_offsets_[u + 1]; }
+  int outDegree(int u) const {
+    return static_cast<int>(out_offsets_[u + 1] - out_offsets_[u]);
+  }
+  // in-arcs of v are [inBegin(v), inEnd(v)) in inSources()/inWeights()
+  size_t inBegin(int v) const { return in_offsets_[v]; }
+  size_t inEnd(int v) const { return in_offsets_[v + 1]; }
+  int inDegree(int v) const {
+    return static_cast<int>(in_offsets_[v + 1] - in_offsets_[v]);
+  }
+
+  const std::vector<size_t> &outOffsets() const { return out_offsets_; }
+  const std::vector<int> &outTargets() const { return out_targets_; }
+  const std::vector<int> &outWeights() const { return out_weights_; }
+  const std::vector<size_t> &inOffsets() const { return in_offsets_; }
+  const std::vector<int> &inSources() const { return in_sources_; }
+  const std::vector<int> &inWeights() const { return in_weights_; }
+
+  // rebuild the Graph<T>::Edge record of an out-arc for result reporting
+  Edge edgeAt(int u, size_t arc) const {
+    return Edge(Vertex(vertexs_[u]), Vertex(vertexs_[out_targets_[arc]]),
+                out_weights_[arc]);
+  }
+
+private:
+  bool directed_ = true;
+  bool has_negative_weight_ = false;
+  std::vector<Pointer> vertexs_;
+  std::unordered_map<Pointer, int> index_of_;
+  std::vector<size_t> out_offsets_{0};
+  std::vector<int> out_targets_;
+  std::vector<int> out_weights_;
+  std::vector<size_t> in_offsets_{0};
+  std::vector<int> in_sources_;
+  std::vector<int> in_weights_;
+};
+
+} // namespace graphTest
@@ -0,0 +1,526 @@
+#pragma once
+#include "graph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graphTest {
+
+// Fully dynamic connectivity on dense vertex ids (Holm, de Lichtenberg and
+// Thorup). Every edge has a level; F_i is a spanning forest of the edges of
+// level >= i and each F_i is kept as Euler tours in treaps. Queries take
+// O(log n), insertions and deletions O(log^2 n) amortized: when a tree edge
+// is deleted, the smaller half is searched for a replacement edge and every
+// edge examined there is pushed one level up, which can happen at most
+// log n times per edge.
+class DynamicConnectivity {
+public:
+  DynamicConnectivity() { addLevel(); }
+
+  // appends an isolated vertex and returns its id
+  int addVertex() {
+    const int id = static_cast<int>(num_vertexs_++);
+    for (size_t i = 0; i < vertex_node_.size(); ++i) {
+      vertex_node_[i].push_back(newNode(true, id));
+      nontree_[i].emplace_back();
+    }
+    return id;
+  }
+
+  size_t numVertexs() const { return num_vertexs_; }
+  size_t numEdges() const { return edge_index_.size(); }
+  size_t numComponents() const { return num_vertexs_ - num_tree_edges_; }
+  // edges of the spanning forest F_0
+  size_t numTreeEdges() const { return num_tree_edges_; }
+
+  // false for a self loop or an edge that is already present
+  bool insertEdge(int u, int v) {
+    if (u == v || edge_index_.count(key(u, v)) != 0) {
+      return false;
+    }
+    int id;
+    if (free_edges_.empty()) {
+      id = static_cast<int>(edges_.size());
+      edges_.emplace_back();
+    } else {
+      id = free_edges_.back();
+      free_edges_.pop_back();
+    }
+    EdgeRec &e = edges_[id];
+    e = EdgeRec();
+    e.u = u;
+    e.v = v;
+    edge_index_[key(u, v)] = id;
+    if (!connected(u, v)) {
+      e.tree = true;
+      link(id, 0);
+      ++num_tree_edges_;
+    } else {
+      addNonTree(id);
+    }
+    return true;
+  }
+
+  // false if the edge is not present
+  bool removeEdge(int u, int v) {
+    auto it = edge_index_.find(key(u, v));
+    if (it == edge_index_.end()) {
+      return false;
+    }
+    const int id = it->second;
+    edge_index_.erase(it);
+    if (!edges_[id].tree) {
+      removeNonTree(id);
+      free_edges_.push_back(id);
+      return true;
+    }
+    const int level = edges_[id].level;
+    for (int i = 0; i <= level; ++i) {
+      cut(id, i);
+    }
+    --num_tree_edges_;
+    const int a = edges_[id].u;
+    const int b = edges_[id].v;
+    free_edges_.push_back(id);
+    for (int i = level; i >= 0; --i) {
+      if (replace(a, b, i)) {
+        ++num_tree_edges_;
+        break;
+      }
+    }
+    return true;
+  }
+
+  bool connected(int u, int v) const {
+    return u == v || root(vertex_node_[0][u]) == root(vertex_node_[0][v]);
+  }
+
+  size_t componentSize(int u) const {
+    return nodes_[root(vertex_node_[0][u])].vertex_count;
+  }
+
+private:
+  struct Node {
+    int left = -1;
+    int right = -1;
+    int parent = -1;
+    std::uint32_t prio = 0;
+    int size = 1;
+    int vertex_count = 0;
+    bool is_vertex = false;
+    // vertex node: the vertex has non-tree edges of this level
+    // arc node: the tree edge has exactly this level (first arc only)
+    bool flag = false;
+    bool sub_vertex_flag = false;
+    bool sub_arc_flag = false;
+    int owner = -1; // vertex id or edge id
+  };
+
+  struct EdgeRec {
+    int u = -1;
+    int v = -1;
+    int level = 0;
+    bool tree = false;
+    // tree edge: the two arc nodes in F_0 .. F_level
+    std::vector<std::pair<int, int>> arcs;
+    // non-tree edge: positions in nontree_[level][u] and nontree_[level][v]
+    size_t pos[2] = {0, 0};
+  };
+
+  static std::uint64_t key(int u, int v) {
+    if (u > v) {
+      std::swap(u, v);
+    }
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(u)) << 32) |
+           static_cast<std::uint32_t>(v);
+  }
+
+  void addLevel() {
+    const size_t level = vertex_node_.size();
+    vertex_node_.emplace_back();
+    nontree_.emplace_back(num_vertexs_);
+    vertex_node_[level].reserve(num_vertexs_);
+    for (size_t v = 0; v < num_vertexs_; ++v) {
+      vertex_node_[level].push_back(newNode(true, static_cast<int>(v)));
+    }
+  }
+
+  void ensureLevel(int level) {
+    while (static_cast<int>(vertex_node_.size()) <= level) {
+      addLevel();
+    }
+  }
+
+  // ---- treap over Euler tour sequences ----
+
+  int newNode(bool is_vertex, int owner) {
+    int x;
+    if (free_nodes_.empty()) {
+      x = static_cast<int>(nodes_.size());
+      nodes_.emplace_back();
+    } else {
+      x = free_nodes_.back();
+      free_nodes_.pop_back();
+      nodes_[x] = Node();
+    }
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 17;
+    rng_ ^= rng_ << 5;
+    nodes_[x].prio = rng_;
+    nodes_[x].is_vertex = is_vertex;
+    nodes_[x].owner = owner;
+    pull(x);
+    return x;
+  }
+
+  int sizeOf(int x) const { return x == -1 ? 0 : nodes_[x].size; }
+
+  void pull(int x) {
+    Node &n = nodes_[x];
+    n.size = 1;
+    n.vertex_count = n.is_vertex ? 1 : 0;
+    n.sub_vertex_flag = n.is_vertex && n.flag;
+    n.sub_arc_flag = !n.is_vertex && n.flag;
+    for (int c : {n.left, n.right}) {
+      if (c != -1) {
+        const Node &cn = nodes_[c];
+        n.size += cn.size;
+        n.vertex_count += cn.vertex_count;
+        n.sub_vertex_flag = n.sub_vertex_flag || cn.sub_vertex_flag;
+        n.sub_arc_flag = n.sub_arc_flag || cn.sub_arc_flag;
+      }
+    }
+  }
+
+  int mergeRec(int a, int b) {
+    if (a == -1) {
+      return b;
+    }
+    if (b == -1) {
+      return a;
+    }
+    if (nodes_[a].prio > nodes_[b].prio) {
+      const int r = mergeRec(nodes_[a].right, b);
+      nodes_[a].right = r;
+      nodes_[r].parent = a;
+      pull(a);
+      return a;
+    }
+    const int l = mergeRec(a, nodes_[b].left);
+    nodes_[b].left = l;
+    nodes_[l].parent = b;
+    pull(b);
+    return b;
+  }
+
+  int join(int a, int b) {
+    const int r = mergeRec(a, b);
+    if (r != -1) {
+      nodes_[r].parent = -1;
+    }
+    return r;
+  }
+
+  // l receives the first k nodes of t, r the rest
+  void splitRec(int t, int k, int &l, int &r) {
+    if (t == -1) {
+      l = r = -1;
+      return;
+    }
+    if (k <= sizeOf(nodes_[t].left)) {
+      int sub_l, sub_r;
+      splitRec(nodes_[t].left, k, sub_l, sub_r);
+      nodes_[t].left = sub_r;
+      if (sub_r != -1) {
+        nodes_[sub_r].parent = t;
+      }
+      l = sub_l;
+      r = t;
+    } else {
+      int sub_l, sub_r;
+      splitRec(nodes_[t].right, k - sizeOf(nodes_[t].left) - 1, sub_l,
+               sub_r);
+      nodes_[t].right = sub_l;
+      if (sub_l != -1) {
+        nodes_[sub_l].parent = t;
+      }
+      l = t;
+      r = sub_r;
+    }
+    pull(t);
+  }
+
+  void split(int t, int k, int &l, int &r) {
+    splitRec(t, k, l, r);
+    if (l != -1) {
+      nodes_[l].parent = -1;
+    }
+    if (r != -1) {
+      nodes_[r].parent = -1;
+    }
+  }
+
+  int root(int x) const {
+    while (nodes_[x].parent != -1) {
+      x = nodes_[x].parent;
+    }
+    return x;
+  }
+
+  // position of x in its sequence
+  int indexOf(int x) const {
+    int pos = sizeOf(nodes_[x].left);
+    while (nodes_[x].parent != -1) {
+      const int p = nodes_[x].parent;
+      if (nodes_[p].right == x) {
+        pos += sizeOf(nodes_[p].left) + 1;
+      }
+      x = p;
+    }
+    return pos;
+  }
+
+  void setFlag(int x, bool flag) {
+    nodes_[x].flag = flag;
+    for (int y = x; y != -1; y = nodes_[y].parent) {
+      pull(y);
+    }
+  }
+
+  // a node of the treap rooted at t whose own flag is set, or -1
+  int findFlagged(int t, bool vertex_flag) const {
+    auto has = [&](int c) {
+      return c != -1 && (vertex_flag ? nodes_[c].sub_vertex_flag
+                                     : nodes_[c].sub_arc_flag);
+    };
+    if (!has(t)) {
+      return -1;
+    }
+    while (true) {
+      const Node &n = nodes_[t];
+      if (n.flag && n.is_vertex == vertex_flag) {
+        return t;
+      }
+      t = has(n.left) ? n.left : n.right;
+    }
+  }
+
+  // rotates the tour containing x so that it starts at x, returns the root
+  int reroot(int x) {
+    int a, b;
+    split(root(x), indexOf(x), a, b);
+    return join(b, a);
+  }
+
+  // ---- HDT ----
+
+  void link(int id, int level) {
+    EdgeRec &e = edges_[id];
+    if (static_cast<int>(e.arcs.size()) <= level) {
+      e.arcs.resize(level + 1, {-1, -1});
+    }
+    const int a1 = newNode(false, id);
+    const int a2 = newNode(false, id);
+    if (level == e.level) {
+      nodes_[a1].flag = true;
+      pull(a1);
+    }
+    e.arcs[level] = {a1, a2};
+    const int tu = reroot(vertex_node_[level][e.u]);
+    const int tv = reroot(vertex_node_[level][e.v]);
+    join(join(join(tu, a1), tv), a2);
+  }
+
+  void cut(int id, int level) {
+    auto [a1, a2] = edges_[id].arcs[level];
+    edges_[id].arcs[level] = {-1, -1};
+    int p1 = indexOf(a1);
+    int p2 = indexOf(a2);
+    if (p1 > p2) {
+      std::swap(p1, p2);
+    }
+    // A a1 B a2 C  ->  B and A C
+    int a, rest, mid, c, dropped;
+    split(root(a1), p1, a, rest);
+    split(rest, 1, dropped, rest);
+    split(rest, p2 - p1 - 1, mid, rest);
+    split(rest, 1, dropped, c);
+    join(a, c);
+    free_nodes_.push_back(a1);
+    free_nodes_.push_back(a2);
+  }
+
+  void addNonTree(int id) {
+    EdgeRec &e = edges_[id];
+    ensureLevel(e.level);
+    const int ends[2] = {e.u, e.v};
+    for (int s = 0; s < 2; ++s) {
+      auto &list = nontree_[e.level][ends[s]];
+      e.pos[s] = list.size();
+      list.push_back(id);
+      if (list.size() == 1) {
+        setFlag(vertex_node_[e.level][ends[s]], true);
+      }
+    }
+  }
+
+  void removeNonTree(int id) {
+    EdgeRec &e = edges_[id];
+    const int ends[2] = {e.u, e.v};
+    for (int s = 0; s < 2; ++s) {
+      auto &list = nontree_[e.level][ends[s]];
+      const int last = list.back();
+      list[e.pos[s]] = last;
+      edges_[last].pos[edges_[last].u == ends[s] ? 0 : 1] = e.pos[s];
+      list.pop_back();
+      if (list.empty()) {
+        setFlag(vertex_node_[e.level][ends[s]], false);
+      }
+    }
+  }
+
+  // looks for a replacement of a deleted tree edge (u, v) on level `level`
+  bool replace(int u, int v, int level) {
+    const int ru = root(vertex_node_[level][u]);
+    const int rv = root(vertex_node_[level][v]);
+    const int small =
+        nodes_[ru].vertex_count <= nodes_[rv].vertex_count ? u : v;
+
+    // push the tree edges of this level inside the smaller tree up
+    int arc;
+    while ((arc = findFlagged(root(vertex_node_[level][small]), false)) !=
+           -1) {
+      const int id = nodes_[arc].owner;
+      setFlag(arc, false);
+      edges_[id].level = level + 1;
+      ensureLevel(level + 1);
+      link(id, level + 1);
+    }
+
+    int x;
+    while ((x = findFlagged(root(vertex_node_[level][small]), true)) != -1) {
+      const int w = nodes_[x].owner;
+      while (!nontree_[level][w].empty()) {
+        const int id = nontree_[level][w].back();
+        const int other = edges_[id].u == w ? edges_[id].v : edges_[id].u;
+        removeNonTree(id);
+        if (root(vertex_node_[level][other]) !=
+            root(vertex_node_[level][small])) {
+          edges_[id].tree = true;
+          for (int i = 0; i <= level; ++i) {
+            link(id, i);
+          }
+          return true;
+        }
+        ++edges_[id].level;
+        addNonTree(id);
+      }
+    }
+    return false;
+  }
+
+  size_t num_vertexs_ = 0;
+  size_t num_tree_edges_ = 0;
+  std::vector<Node> nodes_;
+  std::vector<int> free_nodes_;
+  std::vector<EdgeRec> edges_;
+  std::vector<int> free_edges_;
+  std::unordered_map<std::uint64_t, int> edge_index_;
+  // vertex_node_[level][v]: node of v in the Euler tours of F_level
+  std::vector<std::vector<int>> vertex_node_;
+  // nontree_[level][v]: non-tree edges of that level incident to v
+  std::vector<std::vector<std::vector<int>>> nontree_;
+  std::uint32_t rng_ = 2463534242u;
+};
+
+// An undirected graph that keeps a DynamicConnectivity structure in sync
+// with addEdge/removeEdge/removeVertex, so connected() stays cheap while
+// links go up and down.
+template <typename dataT>
+class DynamicUnDirectedGraph : public UnDirectedGraph<dataT> {
+public:
+  typedef typename Graph<dataT>::Pointer Pointer;
+
+  DynamicUnDirectedGraph() : UnDirectedGraph<dataT>() {};
+
+  bool addEdge(Pointer src, Pointer dest, int weight = 0) override {
+    UnDirectedGraph<dataT>::addEdge(src, dest, weight);
+    conn_.insertEdge(idOf(src), idOf(dest));
+    return true;
+  }
+
+  void removeEdge(Pointer src, Pointer dest) override {
+    UnDirectedGraph<dataT>::removeEdge(src, dest);
+    auto s = id_map_.find(src);
+    auto d = id_map_.find(dest);
+    if (s != id_map_.end() && d != id_map_.end()) {
+      conn_.removeEdge(s->second, d->second);
+    }
+  }
+
+  void removeVertex(Pointer data) override {
+    auto it = id_map_.find(data);
+    if (it != id_map_.end()) {
+      std::vector<typename Graph<dataT>::Edge> edges;
+      this->getOutEdges(data, edges);
+      for (const auto &e : edges) {
+        auto other = id_map_.find(e.to.get_data());
+        if (other != id_map_.end()) {
+          conn_.removeEdge(it->second, other->second);
+        }
+      }
+      // the id stays behind as an isolated vertex of conn_
+      id_map_.erase(it);
+    }
+    Graph<dataT>::removeVertex(data);
+  }
+
+  // false if either vertex is not in the graph
+  bool connected(Pointer a, Pointer b) const {
+    if (!hasVertex(a) || !hasVertex(b)) {
+      return false;
+    }
+    if (a == b) {
+      return true;
+    }
+    auto ia = id_map_.find(a);
+    auto ib = id_map_.find(b);
+    if (ia == id_map_.end() || ib == id_map_.end()) {
+      return false; // one of them never had an edge
+    }
+    return conn_.connected(ia->second, ib->second);
+  }
+
+  // number of vertexs in the component of a, 0 if a is not in the graph
+  size_t componentSize(Pointer a) const {
+    if (!hasVertex(a)) {
+      return 0;
+    }
+    auto it = id_map_.find(a);
+    return it == id_map_.end() ? 1 : conn_.componentSize(it->second);
+  }
+
+  size_t numComponents() const {
+    return this->numVertexs() - conn_.numTreeEdges();
+  }
+
+private:
+  bool hasVertex(Pointer data) const { return this->getIndegrees(data) >= 0; }
+
+  int idOf(Pointer data) {
+    auto it = id_map_.find(data);
+    if (it != id_map_.end()) {
+      return it->second;
+    }
+    const int id = conn_.addVertex();
+    id_map_[data] = id;
+    return id;
+  }
+
+  DynamicConnectivity conn_;
+  std::unordered_map<Pointer, int> id_map_;
+};
+
+} // namespace graphTest
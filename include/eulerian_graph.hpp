@@ -1,144 +1,86 @@
 #pragma once
 #include "basicAlgo.hpp"
 #include "graph.hpp"
-#include <stack>
-#include <unordered_set>
+#include "graph_connected_component.hpp"
+#include "traversal_workspace.hpp"
+#include <iostream>
 #include <vector>
 
 namespace {
 namespace gt = graphTest;
 
+// number of vertexs with at least one incident edge, `first` receives the
+// first of them (or -1)
 template <typename DataT>
-std::vector<typename gt::Graph<DataT>::Pointer>
-getNonZeroDegreeVertexs(const gt::Graph<DataT> *graph) {
-  using Pointer = typename gt::Graph<DataT>::Pointer;
-  std::vector<Pointer> non_zero;
-  for (Pointer v : graph->getAllVertexs()) {
-    const int in_deg = graph->getIndegrees(v);
-    const int out_deg = graph->getOutdegrees(v);
-    if (in_deg + out_deg > 0) {
-      non_zero.push_back(v);
+size_t countNonZeroDegreeVertexs(const gt::CompactGraph<DataT> &cg,
+                                 int &first) {
+  size_t count = 0;
+  first = -1;
+  for (int v = 0; v < static_cast<int>(cg.numVertexs()); ++v) {
+    if (cg.inDegree(v) + cg.outDegree(v) > 0) {
+      if (first == -1) {
+        first = v;
+      }
+      ++count;
     }
   }
-  return non_zero;
+  return count;
 }
 
+// all vertexs with an incident edge lie in one weakly connected component
 template <typename DataT>
-bool isConnectedUndirectedOnNonZero(
-    const gt::Graph<DataT> *graph,
-    const std::vector<typename gt::Graph<DataT>::Pointer> &non_zero) {
-  if (non_zero.empty()) {
-    return false;
-  }
-
-  using Pointer = typename gt::Graph<DataT>::Pointer;
-  std::unordered_set<Pointer> valid(non_zero.begin(), non_zero.end());
-  std::unordered_set<Pointer> visited;
-  std::stack<Pointer> st;
-  auto *mutable_graph = const_cast<gt::Graph<DataT> *>(graph);
-
-  st.push(non_zero.front());
-  visited.insert(non_zero.front());
-  while (!st.empty()) {
-    Pointer cur = st.top();
-    st.pop();
-    for (Pointer nxt : mutable_graph->getNext(cur)) {
-      if (valid.count(nxt) && !visited.count(nxt)) {
-        visited.insert(nxt);
-        st.push(nxt);
-      }
-    }
-  }
-
-  return visited.size() == non_zero.size();
+bool isConnectedUndirectedOnNonZero(gt::TraversalWorkspace<DataT> &ws) {
+  return gt::isWeaklyConnected(ws, true);
 }
 
 template <typename DataT>
-bool isStronglyConnectedOnNonZero(
-    const gt::Graph<DataT> *graph,
-    const std::vector<typename gt::Graph<DataT>::Pointer> &non_zero) {
-  if (non_zero.empty()) {
+bool isStronglyConnectedOnNonZero(gt::TraversalWorkspace<DataT> &ws) {
+  int first = -1;
+  const size_t non_zero = countNonZeroDegreeVertexs(ws.graph(), first);
+  if (non_zero == 0) {
     return false;
   }
-
-  using Pointer = typename gt::Graph<DataT>::Pointer;
-  std::unordered_set<Pointer> valid(non_zero.begin(), non_zero.end());
-  auto *mutable_graph = const_cast<gt::Graph<DataT> *>(graph);
-
-  auto run_dfs = [&](bool reversed) {
-    std::unordered_set<Pointer> visited;
-    std::stack<Pointer> st;
-    st.push(non_zero.front());
-    visited.insert(non_zero.front());
-
-    while (!st.empty()) {
-      Pointer cur = st.top();
-      st.pop();
-      std::vector<Pointer> nexts =
-          reversed ? mutable_graph->getPrev(cur) : mutable_graph->getNext(cur);
-      for (Pointer nxt : nexts) {
-        if (valid.count(nxt) && !visited.count(nxt)) {
-          visited.insert(nxt);
-          st.push(nxt);
-        }
-      }
-    }
-    return visited.size() == non_zero.size();
-  };
-
-  return run_dfs(false) && run_dfs(true);
+  return gt::countReachable(ws, first, true, false) == non_zero &&
+         gt::countReachable(ws, first, false, true) == non_zero;
 }
 
 template <typename DataT>
-bool isEulerianDirected(const gt::Graph<DataT> *graph) {
-  auto non_zero = getNonZeroDegreeVertexs(graph);
-  if (non_zero.empty()) {
-    return false;
-  }
-  if (!isStronglyConnectedOnNonZero(graph, non_zero)) {
+bool isEulerianDirected(gt::TraversalWorkspace<DataT> &ws) {
+  if (!isStronglyConnectedOnNonZero(ws)) {
     return false;
   }
-
-  for (auto v : graph->getAllVertexs()) {
-    if (graph->getIndegrees(v) != graph->getOutdegrees(v)) {
+  const auto &cg = ws.graph();
+  for (int v = 0; v < static_cast<int>(cg.numVertexs()); ++v) {
+    if (cg.inDegree(v) != cg.outDegree(v)) {
       return false;
     }
   }
   return true;
 }
 template <typename DataT>
-bool isEulerianUndirected(const gt::Graph<DataT> *graph) {
-  auto non_zero = getNonZeroDegreeVertexs(graph);
-  if (non_zero.empty()) {
+bool isEulerianUndirected(gt::TraversalWorkspace<DataT> &ws) {
+  if (!isConnectedUndirectedOnNonZero(ws)) {
     return false;
   }
-  if (!isConnectedUndirectedOnNonZero(graph, non_zero)) {
-    return false;
-  }
-
-  for (auto v : graph->getAllVertexs()) {
-    if (graph->getIndegrees(v) % 2 != 0) {
+  const auto &cg = ws.graph();
+  for (int v = 0; v < static_cast<int>(cg.numVertexs()); ++v) {
+    if (cg.inDegree(v) % 2 != 0) {
       return false;
     }
   }
   return true;
 }
 template <typename DataT>
-bool isSemiEulerianDirected(const gt::Graph<DataT> *graph) {
-  auto non_zero = getNonZeroDegreeVertexs(graph);
-  if (non_zero.empty()) {
-    return false;
-  }
-  if (!isStronglyConnectedOnNonZero(graph, non_zero)) {
+bool isSemiEulerianDirected(gt::TraversalWorkspace<DataT> &ws) {
+  if (!isStronglyConnectedOnNonZero(ws)) {
     return false;
   }
 
+  const auto &cg = ws.graph();
   int start_count = 0;
   int end_count = 0;
-  for (auto v : graph->getAllVertexs()) {
-    const int in_deg = graph->getIndegrees(v);
-    const int out_deg = graph->getOutdegrees(v);
-    const int diff = out_deg - in_deg;
+  for (int v = 0; v < static_cast<int>(cg.numVertexs()); ++v) {
+    const int diff = cg.outDegree(v) - cg.inDegree(v);
     if (diff == 1) {
       ++start_count;
     } else if (diff == -1) {
@@ -150,18 +92,15 @@ bool isSemiEulerianDirected(const gt::Graph<DataT> *graph) {
   return start_count == 1 && end_count == 1;
 }
 template <typename DataT>
-bool isSemiEulerianUndirected(const gt::Graph<DataT> *graph) {
-  auto non_zero = getNonZeroDegreeVertexs(graph);
-  if (non_zero.empty()) {
-    return false;
-  }
-  if (!isConnectedUndirectedOnNonZero(graph, non_zero)) {
+bool isSemiEulerianUndirected(gt::TraversalWorkspace<DataT> &ws) {
+  if (!isConnectedUndirectedOnNonZero(ws)) {
     return false;
   }
 
+  const auto &cg = ws.graph();
   int odd_count = 0;
-  for (auto v : graph->getAllVertexs()) {
-    if (graph->getIndegrees(v) % 2 != 0) {
+  for (int v = 0; v < static_cast<int>(cg.numVertexs()); ++v) {
+    if (cg.inDegree(v) % 2 != 0) {
       ++odd_count;
     }
   }
@@ -170,28 +109,42 @@ bool isSemiEulerianUndirected(const gt::Graph<DataT> *graph) {
 } // namespace
 
 namespace graphTest {
-template <typename DataT> bool isEulerian(const Graph<DataT> *graph) {
+template <typename DataT>
+bool isEulerian(const Graph<DataT> *graph, TraversalWorkspace<DataT> &ws) {
   if (graph == nullptr) {
     std::cerr << "input graph is nullptr" << std::endl;
     return false;
   }
+  ws.bind(graph);
   if (graph->isDirected()) {
-    return isEulerianDirected(graph);
+    return isEulerianDirected(ws);
   } else {
-    return isEulerianUndirected(graph);
+    return isEulerianUndirected(ws);
   }
 }
 
-template <typename DataT> bool isSemiEulerian(const Graph<DataT> *graph) {
+template <typename DataT> bool isEulerian(const Graph<DataT> *graph) {
+  TraversalWorkspace<DataT> ws;
+  return isEulerian(graph, ws);
+}
+
+template <typename DataT>
+bool isSemiEulerian(const Graph<DataT> *graph, TraversalWorkspace<DataT> &ws) {
   if (graph == nullptr) {
     std::cerr << "input graph is nullptr" << std::endl;
     return false;
   }
+  ws.bind(graph);
   if (graph->isDirected()) {
-    return isSemiEulerianDirected(graph);
+    return isSemiEulerianDirected(ws);
   } else {
-    return isSemiEulerianUndirected(graph);
+    return isSemiEulerianUndirected(ws);
   }
 }
 
-} // namespace graphTest
\ No newline at end of file
+template <typename DataT> bool isSemiEulerian(const Graph<DataT> *graph) {
+  TraversalWorkspace<DataT> ws;
+  return isSemiEulerian(graph, ws);
+}
+
+} // namespace graphTest
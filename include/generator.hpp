@@ -0,0 +1,120 @@
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace graphTest {
+
+// Minimal C++20 coroutine generator used by the lazy traversals.
+// The coroutine body only runs while the caller advances the iterator, so
+// stopping early (break, dropping the generator) skips the remaining work.
+// A Generator is a move-only, single-pass input range.
+template <typename T> class Generator {
+public:
+  struct promise_type {
+    // points into the suspended coroutine frame, valid until the next resume
+    const T *current = nullptr;
+    std::exception_ptr error;
+
+    Generator get_return_object() {
+      return Generator(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    std::suspend_always yield_value(const T &value) noexcept {
+      current = std::addressof(value);
+      return {};
+    }
+    void return_void() {}
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  class iterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using reference = const T &;
+    using pointer = const T *;
+
+    iterator() = default;
+    explicit iterator(handle_type handle) : handle_(handle) {}
+
+    reference operator*() const { return *handle_.promise().current; }
+    pointer operator->() const { return handle_.promise().current; }
+    iterator &operator++() {
+      advance(handle_);
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const {
+      return !handle_ || handle_.done();
+    }
+
+  private:
+    handle_type handle_ = nullptr;
+  };
+
+  Generator() = default;
+  Generator(const Generator &) = delete;
+  Generator &operator=(const Generator &) = delete;
+  Generator(Generator &&other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  Generator &operator=(Generator &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+  ~Generator() { destroy(); }
+
+  // resumes the coroutine up to its first yield
+  iterator begin() {
+    if (handle_ && !started_) {
+      started_ = true;
+      advance(handle_);
+    }
+    return iterator(handle_);
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+  // Pull-style access, convenient for interleaving generators:
+  // `while (gen.next()) use(gen.value());`
+  bool next() {
+    if (!handle_ || handle_.done()) {
+      return false;
+    }
+    started_ = true;
+    advance(handle_);
+    return !handle_.done();
+  }
+  const T &value() const { return *handle_.promise().current; }
+
+private:
+  explicit Generator(handle_type handle) : handle_(handle) {}
+
+  static void advance(handle_type handle) {
+    handle.resume();
+    if (handle.promise().error) {
+      std::rethrow_exception(handle.promise().error);
+    }
+  }
+
+  void destroy() {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+  handle_type handle_ = nullptr;
+  bool started_ = false;
+};
+
+} // namespace graphTest
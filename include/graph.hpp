@@ -24,9 +24,12 @@ public:
   }
   virtual bool isDirected() const = 0 ;
 
-  void removeVertex(Pointer data) {
+  virtual void removeVertex(Pointer data) {
     auto it = out_map_.find(Vertex(data));
     if (it != out_map_.end()) {
+      for (const auto &e : it->second) {
+        countNegative(e.weight_, -1);
+      }
       out_map_.erase(it);
     }
     it = in_map_.find(Vertex(data));
@@ -35,7 +38,13 @@ public:
     }
     // remove all edges related to this vertex
     for (auto &pair : out_map_) {
-      pair.second.remove_if([data](const Edge &e) { return e.to == data; });
+      pair.second.remove_if([this, data](const Edge &e) {
+        if (e.to == data) {
+          countNegative(e.weight_, -1);
+          return true;
+        }
+        return false;
+      });
     }
     for (auto &pair : in_map_) {
       pair.second.remove_if([data](const Edge &e) { return e.from == data; });
@@ -128,11 +137,13 @@ public:
         out_map_iter->second.push_back(cur_edge);
       } else {
         // weight exists, update it
+        countNegative(edge_iter->weight_, -1);
         edge_iter->weight_ = weight;
       }
     } else {
       out_map_[Vertex(src)].push_back(cur_edge);
     }
+    countNegative(weight, 1);
     return true;
   }
   virtual void removeEdge(Pointer src, Pointer dest) {
@@ -145,8 +156,13 @@ public:
           [cur_edge](const Edge &e) { return e == cur_edge; });
     }
     if (out_map_iter != out_map_.end()) {
-      out_map_iter->second.remove_if(
-          [cur_edge](const Edge &e) { return e == cur_edge; });
+      out_map_iter->second.remove_if([this, cur_edge](const Edge &e) {
+        if (e == cur_edge) {
+          countNegative(e.weight_, -1);
+          return true;
+        }
+        return false;
+      });
     }
   }
   virtual int getIndegrees(Pointer data) const {
@@ -162,6 +178,9 @@ public:
       return -1;
   }
   virtual size_t numVertexs() const { return in_map_.size(); }
+  // kept up to date by addEdge/removeEdge/removeVertex, so algorithms that
+  // reject negative weights do not have to scan every edge
+  bool hasNegativeWeight() const { return num_negative_arcs_ > 0; }
   virtual std::vector<Pointer> getAllVertexs() const {
     std::vector<Pointer> vertexs;
     for (const auto &pair : in_map_) {
@@ -259,6 +278,17 @@ protected:
   std::unordered_map<Vertex, std::list<Edge>, VertexHash> in_map_;
   std::unordered_map<Vertex, std::list<Edge>, VertexHash> out_map_;
   size_t vertex_id_counter_ = 0;
+
+private:
+  void countNegative(int weight, int delta) {
+    if (weight < 0) {
+      num_negative_arcs_ = static_cast<size_t>(
+          static_cast<long long>(num_negative_arcs_) + delta);
+    }
+  }
+
+  // out-arcs with a negative weight, an undirected edge counts twice
+  size_t num_negative_arcs_ = 0;
 };
 
 template <typename dataT> class DirectedGraph : public Graph<dataT> {
@@ -1,101 +1,107 @@
 #pragma once
 #include "graph.hpp"
+#include "traversal_workspace.hpp"
 #include <iostream>
 #include <ostream>
-#include <queue>
+#include <vector>
 namespace graphTest {
 
 namespace {
-template <typename dataT> bool hasCircleDirected(Graph<dataT> *g) {
-  // DFS 三色标记法 for 有向图
-  // TODO
-  if (!g->isDirected()) {
-    std::cerr << "function for directed graph\n";
-    return false;
-  }
-  std::unordered_map<typename Graph<dataT>::Pointer, int> color;
-  auto vertexs = g->getAllVertexs();
-  for (auto v : vertexs) {
-    color[v] = 0;
-  }
-
-  std::function<bool(typename Graph<dataT>::Pointer)> dfs =
-      [&](typename Graph<dataT>::Pointer node) -> bool {
-    color[node] = 1;
-
-    for (auto neighbor : g->getNext(node)) {
-      if (color[neighbor] == 1) {
-        return true;
-      }
-      if (color[neighbor] == 0) {
-        if (dfs(neighbor)) {
-          return true;
-        }
-      }
+template <typename dataT>
+bool hasCircleDirected(TraversalWorkspace<dataT> &ws) {
+  // DFS 三色标记法 for 有向图, iterative with per-vertex arc cursors
+  const auto &cg = ws.graph();
+  const auto &targets = cg.outTargets();
+  std::vector<int> &stk = ws.stack();
+  ws.newEpoch();
+  for (int v = 0; v < static_cast<int>(cg.numVertexs()); ++v) {
+    if (ws.state(v) != 0) {
+      continue;
     }
-
-    color[node] = 2;
-    return false;
-  };
-
-  for (auto v : vertexs) {
-    if (color[v] == 0) {
-      if (dfs(v)) {
+    stk.clear();
+    ws.setState(v, 1);
+    ws.cursor(v) = cg.outBegin(v);
+    stk.push_back(v);
+    while (!stk.empty()) {
+      const int u = stk.back();
+      if (ws.cursor(u) == cg.outEnd(u)) {
+        ws.setState(u, 2);
+        stk.pop_back();
+        continue;
+      }
+      const int w = targets[ws.cursor(u)++];
+      const int color = ws.state(w);
+      if (color == 1) {
         return true;
       }
+      if (color == 0) {
+        ws.setState(w, 1);
+        ws.cursor(w) = cg.outBegin(w);
+        stk.push_back(w);
+      }
     }
   }
   return false;
 }
 
-template <typename dataT> bool hasCircleUNDirected(Graph<dataT> *g) {
-  if (g->isDirected()) {
-    std::cerr << "function for undirected graph\n";
-    return false;
-  }
-  std::unordered_set<typename Graph<dataT>::Pointer> visited;
-
-  std::function<bool(typename Graph<dataT>::Pointer,
-                     typename Graph<dataT>::Pointer)>
-      dfs = [&](typename Graph<dataT>::Pointer node,
-                typename Graph<dataT>::Pointer parent) -> bool {
-    visited.insert(node);
-
-    for (auto neighbor : g->getNext(node)) {
-      if (neighbor == parent) {
+template <typename dataT>
+bool hasCircleUNDirected(TraversalWorkspace<dataT> &ws) {
+  // value(v) keeps the DFS parent, the arc back to it is not a cycle
+  const auto &cg = ws.graph();
+  const auto &targets = cg.outTargets();
+  std::vector<int> &stk = ws.stack();
+  ws.newEpoch();
+  for (int v = 0; v < static_cast<int>(cg.numVertexs()); ++v) {
+    if (ws.state(v) != 0) {
+      continue;
+    }
+    stk.clear();
+    ws.setState(v, 1);
+    ws.value(v) = -1;
+    ws.cursor(v) = cg.outBegin(v);
+    stk.push_back(v);
+    while (!stk.empty()) {
+      const int u = stk.back();
+      if (ws.cursor(u) == cg.outEnd(u)) {
+        stk.pop_back();
         continue;
       }
-      if (visited.count(neighbor)) {
-        return true;
-      }
-      if (dfs(neighbor, node)) {
-        return true;
+      const int w = targets[ws.cursor(u)++];
+      if (w == ws.value(u)) {
+        continue;
       }
-    }
-    return false;
-  };
-
-  auto vertexs = g->getAllVertexs();
-  for (auto v : vertexs) {
-    if (!visited.count(v)) {
-      if (dfs(v, nullptr)) {
+      if (ws.state(w) != 0) {
         return true;
       }
+      ws.setState(w, 1);
+      ws.value(w) = u;
+      ws.cursor(w) = cg.outBegin(w);
+      stk.push_back(w);
     }
   }
   return false;
 }
 } // namespace
 
-template <typename dataT> bool hasCircle(Graph<dataT> *g) {
-  // DFS 三色标记法 for 有向图
+template <typename dataT>
+bool hasCircle(Graph<dataT> *g, TraversalWorkspace<dataT> &ws) {
+  if (g == nullptr) {
+    std::cerr << "nullptr input graph\n";
+    return false;
+  }
+  ws.bind(g);
   if (g->isDirected()) {
-    return hasCircleDirected(g);
+    return hasCircleDirected(ws);
   } else {
-    return hasCircleUNDirected(g);
+    return hasCircleUNDirected(ws);
   }
 }
 
+template <typename dataT> bool hasCircle(Graph<dataT> *g) {
+  TraversalWorkspace<dataT> ws;
+  return hasCircle(g, ws);
+}
+
 template <typename dataT> bool isSame(Graph<dataT> *g1, Graph<dataT> *g2) {
   auto g1_v = g1->getAllVertexs();
   auto g2_v = g2->getAllVertexs();
@@ -128,51 +134,62 @@ template <typename T> bool isDAG(Graph<T> *g) {
   return (g->isDirected()) && (!hasCircle(g));
 }
 
-template <typename T> bool isBipartite(Graph<T> *g) {
+template <typename T>
+bool isBipartite(Graph<T> *g, TraversalWorkspace<T> &ws) {
   if (g == nullptr) {
     std::cerr << "nullptr input graph\n";
     return false;
   }
-  std::unordered_map<typename Graph<T>::Pointer, int> color;
-  for (auto v : g->getAllVertexs()) {
-    color[v] = 0;
-  }
-  std::vector<typename Graph<T>::Pointer> start_nodes;
+  ws.bind(g);
+  const auto &cg = ws.graph();
+  const auto &targets = cg.outTargets();
+  const int n = static_cast<int>(cg.numVertexs());
+  // color is the workspace state: 0 uncolored, 1 and 2 the two sides
+  std::vector<int> &start_nodes = ws.stack();
+  start_nodes.clear();
   if (g->isDirected()) {
     // 有向图：从入度为0的顶点开始
-    for (auto v : g->getAllVertexs()) {
-      if (g->getIndegrees(v) == 0) {
-         
+    for (int v = 0; v < n; ++v) {
+      if (cg.inDegree(v) == 0) {
         start_nodes.push_back(v);
       }
     }
-    // 如果没有入度为0的顶点（有环），从任意未访问顶点开始
-    if (start_nodes.empty()) {
-      start_nodes = g->getAllVertexs();
+  }
+  // 无向图或者没有入度为0的顶点（有环）：从所有顶点开始（处理多个连通分量）
+  if (start_nodes.empty()) {
+    for (int v = 0; v < n; ++v) {
+      start_nodes.push_back(v);
     }
-  } else {
-    // 无向图：从所有未访问的顶点开始（处理多个连通分量）
-    start_nodes = g->getAllVertexs();
   }
-  for (auto v :start_nodes) {
-    if (color[v] == 0) {
-      std::queue<typename Graph<T>::Pointer> q;
-      q.push(v);
-      color[v] = 1;
-      while (!q.empty()) {
-        auto u = q.front();
-        q.pop();
-        for (auto v : g->getNext(u)) {
-          if (color[v] == 0) {
-            color[v] = 3 - color[u];
-            q.push(v);
-          } else if (color[v] == color[u]) {
-            return false;
-          }
+  ws.newEpoch();
+  std::vector<int> &q = ws.queue();
+  for (int v : start_nodes) {
+    if (ws.state(v) != 0) {
+      continue;
+    }
+    q.clear();
+    q.push_back(v);
+    ws.setState(v, 1);
+    for (size_t head = 0; head < q.size(); ++head) {
+      const int u = q[head];
+      const int color_u = ws.state(u);
+      for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+        const int w = targets[a];
+        const int color_w = ws.state(w);
+        if (color_w == 0) {
+          ws.setState(w, 3 - color_u);
+          q.push_back(w);
+        } else if (color_w == color_u) {
+          return false;
         }
       }
     }
   }
   return true;
 }
+
+template <typename T> bool isBipartite(Graph<T> *g) {
+  TraversalWorkspace<T> ws;
+  return isBipartite(g, ws);
+}
 } // namespace graphTest
\ No newline at end of file
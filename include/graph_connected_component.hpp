@@ -1,9 +1,14 @@
 #pragma once
+#include "basicAlgo.hpp"
+#include "compact_graph.hpp"
 #include "graph.hpp"
+#include "parallel.hpp"
+#include "traversal_workspace.hpp"
 #include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <queue>
+#include <random>
 #include <stack>
 #include <unordered_map>
 #include <unordered_set>
@@ -30,248 +35,617 @@ template <typename DataT> struct BlockForestResult {
 
   std::vector<Tree> trees;
 };
-} // namespace graphTest
 
-namespace {
-template <typename DataT>
-void tarjanDFS(
-    typename graphTest::Graph<DataT>::Pointer u,
-    const graphTest::Graph<DataT> *graph, int &timer,
-    std::unordered_map<typename graphTest::Graph<DataT>::Pointer, int> &dfn,
-    std::unordered_map<typename graphTest::Graph<DataT>::Pointer, int> &low,
-    std::stack<typename graphTest::Graph<DataT>::Pointer> &st,
-    std::unordered_set<typename graphTest::Graph<DataT>::Pointer> &in_st,
-    std::vector<std::vector<typename graphTest::Graph<DataT>::Pointer>> &sccs) {
-  typedef typename graphTest::Graph<DataT>::Pointer Pointer;
-  dfn[u] = low[u] = ++timer;
-  st.push(u);
-  in_st.insert(u);
-
-  std::vector<typename graphTest::Graph<DataT>::Edge> outEdges;
-  graph->getOutEdges(u, outEdges);
-  for (const auto &edge : outEdges) {
-    Pointer v = edge.to.get_data();
-    if (dfn.find(v) == dfn.end()) {
-      tarjanDFS<DataT>(v, graph, timer, dfn, low, st, in_st, sccs);
-      low[u] = std::min(low[u], low[v]);
-    } else if (in_st.find(v) != in_st.end()) {
-      low[u] = std::min(low[u], dfn[v]);
+enum CCAlgo { UnionFindCC, Afforest };
+
+// Component label per vertex. vertexs are in getAllVertexs() order (the
+// CompactGraph numbering) and label[i] is the component of vertexs[i].
+// Labels are dense, 0..count-1; each function documents their order.
+template <typename DataT> struct ComponentLabels {
+  typedef typename Graph<DataT>::Pointer Pointer;
+
+  std::vector<Pointer> vertexs;
+  std::vector<int> label;
+  int count = 0;
+
+  // members of component c are members[offsets[c]] .. members[offsets[c+1]-1]
+  void getMembers(std::vector<int> &offsets, std::vector<int> &members) const {
+    offsets.assign(count + 1, 0);
+    for (int l : label) {
+      ++offsets[l + 1];
+    }
+    for (int c = 0; c < count; ++c) {
+      offsets[c + 1] += offsets[c];
+    }
+    members.resize(label.size());
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < label.size(); ++i) {
+      members[fill[label[i]]++] = static_cast<int>(i);
     }
   }
 
-  if (dfn[u] == low[u]) {
-    std::vector<Pointer> component;
-    while (true) {
-      Pointer v = st.top();
-      st.pop();
-      in_st.erase(v);
-      component.push_back(v);
-      if (v == u)
-        break;
+  std::vector<std::vector<Pointer>> toGroups() const {
+    std::vector<std::vector<Pointer>> groups(count);
+    for (size_t i = 0; i < label.size(); ++i) {
+      groups[label[i]].push_back(vertexs[i]);
     }
-    sccs.push_back(component);
+    return groups;
   }
-}
+};
+
+// Components that may share vertexs (vertex-biconnected components), in
+// flat form: component c holds vertexs[members[offsets[c]]] ..
+// vertexs[members[offsets[c + 1] - 1]].
+template <typename DataT> struct ComponentMembers {
+  typedef typename Graph<DataT>::Pointer Pointer;
+
+  std::vector<Pointer> vertexs;
+  std::vector<int> offsets{0};
+  std::vector<int> members;
+
+  int count() const { return static_cast<int>(offsets.size()) - 1; }
+
+  std::vector<std::vector<Pointer>> toGroups() const {
+    std::vector<std::vector<Pointer>> groups(count());
+    for (int c = 0; c < count(); ++c) {
+      groups[c].reserve(offsets[c + 1] - offsets[c]);
+      for (int i = offsets[c]; i < offsets[c + 1]; ++i) {
+        groups[c].push_back(vertexs[members[i]]);
+      }
+    }
+    return groups;
+  }
+};
+} // namespace graphTest
 
+namespace {
+// Iterative Tarjan over the workspace snapshot. Workspace state is
+// 0 unvisited, 1 on the component stack, 2 assigned; value() is dfn.
+// Components are labeled in reverse topological order.
 template <typename DataT>
-std::vector<std::vector<typename graphTest::Graph<DataT>::Pointer>>
-getSCCTarjan(const graphTest::Graph<DataT> *graph) {
-  typedef typename graphTest::Graph<DataT>::Pointer Pointer;
-  std::vector<std::vector<Pointer>> sccs;
-  std::unordered_map<Pointer, int> dfn, low;
-  std::stack<Pointer> st;
-  std::unordered_set<Pointer> in_st;
+void sccLabelsTarjan(graphTest::TraversalWorkspace<DataT> &ws,
+                     graphTest::ComponentLabels<DataT> &res) {
+  const auto &cg = ws.graph();
+  const auto &targets = cg.outTargets();
+  res.vertexs = cg.vertexs();
+  res.label.assign(cg.numVertexs(), -1);
+  res.count = 0;
+  std::vector<int> &call = ws.stack();
+  std::vector<int> &st = ws.order();
+  call.clear();
+  st.clear();
+  ws.newEpoch();
   int timer = 0;
 
-  std::vector<Pointer> vertices = graph->getAllVertexs();
-  for (Pointer v : vertices) {
-    if (dfn.find(v) == dfn.end()) {
-      tarjanDFS<DataT>(v, graph, timer, dfn, low, st, in_st, sccs);
+  auto enter = [&](int v) {
+    ws.setState(v, 1);
+    ws.value(v) = ws.low(v) = ++timer;
+    ws.cursor(v) = cg.outBegin(v);
+    call.push_back(v);
+    st.push_back(v);
+  };
+  for (int root = 0; root < static_cast<int>(cg.numVertexs()); ++root) {
+    if (ws.state(root) != 0) {
+      continue;
+    }
+    enter(root);
+    while (!call.empty()) {
+      const int u = call.back();
+      if (ws.cursor(u) < cg.outEnd(u)) {
+        const int v = targets[ws.cursor(u)++];
+        const int state = ws.state(v);
+        if (state == 0) {
+          enter(v);
+        } else if (state == 1) {
+          ws.low(u) = std::min(ws.low(u), ws.value(v));
+        }
+        continue;
+      }
+      call.pop_back();
+      if (ws.value(u) == ws.low(u)) {
+        while (true) {
+          const int v = st.back();
+          st.pop_back();
+          ws.setState(v, 2);
+          res.label[v] = res.count;
+          if (v == u)
+            break;
+        }
+        ++res.count;
+      }
+      if (!call.empty()) {
+        const int p = call.back();
+        ws.low(p) = std::min(ws.low(p), ws.low(u));
+      }
     }
   }
-  return sccs;
 }
 
+// Iterative Kosaraju: postorder on out-arcs, then collect components on
+// in-arcs in reverse postorder. Components are labeled in topological
+// order.
 template <typename DataT>
-void kosarajuDFS1(
-    typename graphTest::Graph<DataT>::Pointer u,
-    const graphTest::Graph<DataT> *graph,
-    std::unordered_set<typename graphTest::Graph<DataT>::Pointer> &visited,
-    std::vector<typename graphTest::Graph<DataT>::Pointer> &order) {
-  typedef typename graphTest::Graph<DataT>::Pointer Pointer;
-  visited.insert(u);
-  std::vector<typename graphTest::Graph<DataT>::Edge> outEdges;
-  graph->getOutEdges(u, outEdges);
-  for (const auto &edge : outEdges) {
-    Pointer v = edge.to.get_data();
-    if (visited.find(v) == visited.end()) {
-      kosarajuDFS1<DataT>(v, graph, visited, order);
+void sccLabelsKosaraju(graphTest::TraversalWorkspace<DataT> &ws,
+                       graphTest::ComponentLabels<DataT> &res) {
+  const auto &cg = ws.graph();
+  const auto &targets = cg.outTargets();
+  const auto &sources = cg.inSources();
+  const int n = static_cast<int>(cg.numVertexs());
+  std::vector<int> &call = ws.stack();
+  std::vector<int> &order = ws.order();
+  order.clear();
+  ws.newEpoch();
+  for (int root = 0; root < n; ++root) {
+    if (ws.state(root) != 0) {
+      continue;
+    }
+    call.clear();
+    ws.setState(root, 1);
+    ws.cursor(root) = cg.outBegin(root);
+    call.push_back(root);
+    while (!call.empty()) {
+      const int u = call.back();
+      if (ws.cursor(u) < cg.outEnd(u)) {
+        const int v = targets[ws.cursor(u)++];
+        if (ws.state(v) == 0) {
+          ws.setState(v, 1);
+          ws.cursor(v) = cg.outBegin(v);
+          call.push_back(v);
+        }
+        continue;
+      }
+      call.pop_back();
+      order.push_back(u);
     }
   }
-  order.push_back(u);
-}
 
-template <typename DataT>
-void kosarajuDFS2(
-    typename graphTest::Graph<DataT>::Pointer u,
-    const graphTest::Graph<DataT> *graph,
-    std::unordered_set<typename graphTest::Graph<DataT>::Pointer> &visited,
-    std::vector<typename graphTest::Graph<DataT>::Pointer> &component) {
-  typedef typename graphTest::Graph<DataT>::Pointer Pointer;
-  visited.insert(u);
-  component.push_back(u);
-  std::vector<typename graphTest::Graph<DataT>::Edge> inEdges;
-  graph->getInEdges(u, inEdges);
-  for (const auto &edge : inEdges) {
-    Pointer v = edge.from.get_data();
-    if (visited.find(v) == visited.end()) {
-      kosarajuDFS2<DataT>(v, graph, visited, component);
+  ws.newEpoch();
+  res.vertexs = cg.vertexs();
+  res.label.assign(n, -1);
+  res.count = 0;
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    if (ws.state(*it) != 0) {
+      continue;
     }
+    call.clear();
+    ws.setState(*it, 1);
+    call.push_back(*it);
+    while (!call.empty()) {
+      const int u = call.back();
+      call.pop_back();
+      res.label[u] = res.count;
+      for (size_t a = cg.inBegin(u); a < cg.inEnd(u); ++a) {
+        const int v = sources[a];
+        if (ws.state(v) == 0) {
+          ws.setState(v, 1);
+          call.push_back(v);
+        }
+      }
+    }
+    ++res.count;
   }
 }
 
+// Iterative Tarjan for vertex-biconnected components on an undirected
+// snapshot. value() is dfn; the parent of the top of `call` is the entry
+// below it. A vertex without any edge forms a component on its own.
 template <typename DataT>
-std::vector<std::vector<typename graphTest::Graph<DataT>::Pointer>>
-getSCCKosaraju(const graphTest::Graph<DataT> *graph) {
-  typedef typename graphTest::Graph<DataT>::Pointer Pointer;
-  std::vector<Pointer> order;
-  std::unordered_set<Pointer> visited;
-  std::vector<Pointer> vertices = graph->getAllVertexs();
-
-  for (Pointer v : vertices) {
-    if (visited.find(v) == visited.end()) {
-      kosarajuDFS1<DataT>(v, graph, visited, order);
-    }
-  }
+void vbccMembers(graphTest::TraversalWorkspace<DataT> &ws,
+                 graphTest::ComponentMembers<DataT> &res) {
+  const auto &cg = ws.graph();
+  const auto &targets = cg.outTargets();
+  res.vertexs = cg.vertexs();
+  res.offsets.assign(1, 0);
+  res.members.clear();
+  std::vector<int> &call = ws.stack();
+  std::vector<int> &st = ws.order();
+  ws.newEpoch();
+  int timer = 0;
 
-  visited.clear();
-  std::vector<std::vector<Pointer>> sccs;
-  for (auto it = order.rbegin(); it != order.rend(); ++it) {
-    Pointer v = *it;
-    if (visited.find(v) == visited.end()) {
-      std::vector<Pointer> component;
-      kosarajuDFS2<DataT>(v, graph, visited, component);
-      sccs.push_back(component);
+  auto enter = [&](int v) {
+    ws.setState(v, 1);
+    ws.value(v) = ws.low(v) = ++timer;
+    ws.cursor(v) = cg.outBegin(v);
+    call.push_back(v);
+    st.push_back(v);
+  };
+  for (int root = 0; root < static_cast<int>(cg.numVertexs()); ++root) {
+    if (ws.state(root) != 0) {
+      continue;
+    }
+    call.clear();
+    st.clear();
+    enter(root);
+    while (!call.empty()) {
+      const int u = call.back();
+      const int p = call.size() > 1 ? call[call.size() - 2] : -1;
+      if (ws.cursor(u) < cg.outEnd(u)) {
+        const int v = targets[ws.cursor(u)++];
+        if (v == p) {
+          continue;
+        }
+        if (ws.state(v) == 0) {
+          enter(v);
+        } else {
+          ws.low(u) = std::min(ws.low(u), ws.value(v));
+        }
+        continue;
+      }
+      call.pop_back();
+      if (p == -1) {
+        if (timer == ws.value(u)) { // no child
+          res.members.push_back(u);
+          res.offsets.push_back(static_cast<int>(res.members.size()));
+        }
+        continue;
+      }
+      ws.low(p) = std::min(ws.low(p), ws.low(u));
+      if (ws.low(u) >= ws.value(p)) {
+        while (true) {
+          const int top = st.back();
+          st.pop_back();
+          res.members.push_back(top);
+          if (top == u)
+            break;
+        }
+        res.members.push_back(p);
+        res.offsets.push_back(static_cast<int>(res.members.size()));
+      }
     }
   }
-  return sccs;
 }
 
+// Iterative Tarjan for edge-biconnected components on an undirected
+// snapshot. Components are labeled in the order they are closed.
 template <typename DataT>
-void tarjanVBCCDFS(
-    typename graphTest::Graph<DataT>::Pointer u,
-    typename graphTest::Graph<DataT>::Pointer p,
-    const graphTest::Graph<DataT> *graph, int &timer,
-    std::unordered_map<typename graphTest::Graph<DataT>::Pointer, int> &dfn,
-    std::unordered_map<typename graphTest::Graph<DataT>::Pointer, int> &low,
-    std::stack<typename graphTest::Graph<DataT>::Pointer> &st,
-    std::vector<std::vector<typename graphTest::Graph<DataT>::Pointer>>
-        &vbccs) {
-  typedef typename graphTest::Graph<DataT>::Pointer Pointer;
-  dfn[u] = low[u] = ++timer;
-  st.push(u);
-
-  std::vector<typename graphTest::Graph<DataT>::Edge> outEdges;
-  graph->getOutEdges(u, outEdges);
-  int children = 0;
-  for (const auto &edge : outEdges) {
-    Pointer v = edge.to.get_data();
-    if (v == p)
+void ebccLabels(graphTest::TraversalWorkspace<DataT> &ws,
+                graphTest::ComponentLabels<DataT> &res) {
+  const auto &cg = ws.graph();
+  const auto &targets = cg.outTargets();
+  res.vertexs = cg.vertexs();
+  res.label.assign(cg.numVertexs(), -1);
+  res.count = 0;
+  std::vector<int> &call = ws.stack();
+  std::vector<int> &st = ws.order();
+  call.clear();
+  st.clear();
+  ws.newEpoch();
+  int timer = 0;
+
+  auto enter = [&](int v) {
+    ws.setState(v, 1);
+    ws.value(v) = ws.low(v) = ++timer;
+    ws.cursor(v) = cg.outBegin(v);
+    call.push_back(v);
+    st.push_back(v);
+  };
+  for (int root = 0; root < static_cast<int>(cg.numVertexs()); ++root) {
+    if (ws.state(root) != 0) {
       continue;
-    if (dfn.find(v) == dfn.end()) {
-      children++;
-      tarjanVBCCDFS<DataT>(v, u, graph, timer, dfn, low, st, vbccs);
-      low[u] = std::min(low[u], low[v]);
-      if (low[v] >= dfn[u]) {
-        std::vector<Pointer> component;
+    }
+    enter(root);
+    while (!call.empty()) {
+      const int u = call.back();
+      const int p = call.size() > 1 ? call[call.size() - 2] : -1;
+      if (ws.cursor(u) < cg.outEnd(u)) {
+        const int v = targets[ws.cursor(u)++];
+        if (v == p) {
+          continue;
+        }
+        if (ws.state(v) == 0) {
+          enter(v);
+        } else {
+          ws.low(u) = std::min(ws.low(u), ws.value(v));
+        }
+        continue;
+      }
+      call.pop_back();
+      if (ws.value(u) == ws.low(u)) {
         while (true) {
-          Pointer top = st.top();
-          st.pop();
-          component.push_back(top);
-          if (top == v)
+          const int v = st.back();
+          st.pop_back();
+          res.label[v] = res.count;
+          if (v == u)
             break;
         }
-        component.push_back(u);
-        vbccs.push_back(component);
+        ++res.count;
+      }
+      if (p != -1) {
+        ws.low(p) = std::min(ws.low(p), ws.low(u));
       }
-    } else {
-      low[u] = std::min(low[u], dfn[v]);
     }
   }
-  if (p == nullptr && children == 0) {
-    vbccs.push_back({u});
+}
+
+// Dense relabeling of component roots, numbered by their first vertex.
+template <typename DataT, typename FindRoot>
+void relabelComponents(const graphTest::CompactGraph<DataT> &cg,
+                       FindRoot findRoot,
+                       graphTest::ComponentLabels<DataT> &res) {
+  const int n = static_cast<int>(cg.numVertexs());
+  res.vertexs = cg.vertexs();
+  res.label.assign(n, -1);
+  res.count = 0;
+  std::vector<int> label_of_root(n, -1);
+  for (int v = 0; v < n; ++v) {
+    const int root = findRoot(v);
+    if (label_of_root[root] == -1) {
+      label_of_root[root] = res.count++;
+    }
+    res.label[v] = label_of_root[root];
   }
 }
 
+// Serial union-find over the out-arcs, which is enough for both directions:
+// every edge is an out-arc of one of its ends.
 template <typename DataT>
-void tarjanEBCCDFS(
-    typename graphTest::Graph<DataT>::Pointer u,
-    typename graphTest::Graph<DataT>::Pointer p,
-    const graphTest::Graph<DataT> *graph, int &timer,
-    std::unordered_map<typename graphTest::Graph<DataT>::Pointer, int> &dfn,
-    std::unordered_map<typename graphTest::Graph<DataT>::Pointer, int> &low,
-    std::stack<typename graphTest::Graph<DataT>::Pointer> &st,
-    std::vector<std::vector<typename graphTest::Graph<DataT>::Pointer>>
-        &ebccs) {
-  typedef typename graphTest::Graph<DataT>::Pointer Pointer;
-  dfn[u] = low[u] = ++timer;
-  st.push(u);
-
-  std::vector<typename graphTest::Graph<DataT>::Edge> outEdges;
-  graph->getOutEdges(u, outEdges);
-  for (const auto &edge : outEdges) {
-    Pointer v = edge.to.get_data();
-    if (v == p)
-      continue;
-    if (dfn.find(v) == dfn.end()) {
-      tarjanEBCCDFS<DataT>(v, u, graph, timer, dfn, low, st, ebccs);
-      low[u] = std::min(low[u], low[v]);
-    } else {
-      low[u] = std::min(low[u], dfn[v]);
+void connectedComponentsUnionFind(const graphTest::CompactGraph<DataT> &cg,
+                                  graphTest::ComponentLabels<DataT> &res) {
+  const int n = static_cast<int>(cg.numVertexs());
+  graphTest::DisjointSets sets(n);
+  for (int u = 0; u < n; ++u) {
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      sets.merge(u, cg.outTargets()[a]);
     }
   }
+  relabelComponents(cg, [&](int v) { return sets.find(v); }, res);
+}
+
+// Afforest (Sutton et al.): link every vertex with its first few neighbors,
+// guess the giant component from a sample of vertexs, then process the
+// remaining arcs only for vertexs outside it. Most arcs of a large graph
+// lie inside the giant component and are never touched. Skipping a vertex
+// is only sound when its arcs are also seen from the other end, so for a
+// directed graph the in-arcs of the processed vertexs are linked as well.
+template <typename DataT>
+void afforestLink(const graphTest::CompactGraph<DataT> &cg,
+                  size_t num_threads, graphTest::ConcurrentDisjointSets &sets) {
+  const int n = static_cast<int>(cg.numVertexs());
+  const int neighbor_rounds = 2;
+  const size_t sample_size = 1024;
+  sets.reset(n);
+
+  for (int r = 0; r < neighbor_rounds; ++r) {
+    graphTest::parallelForBlocks(
+        n, num_threads, [&](size_t, size_t begin, size_t end) {
+          for (size_t u = begin; u < end; ++u) {
+            const int v = static_cast<int>(u);
+            if (cg.outDegree(v) > r) {
+              sets.merge(v, cg.outTargets()[cg.outBegin(v) + r]);
+            }
+          }
+        });
+  }
 
-  if (dfn[u] == low[u]) {
-    std::vector<Pointer> component;
-    while (true) {
-      Pointer v = st.top();
-      st.pop();
-      component.push_back(v);
-      if (v == u)
-        break;
+  int giant = -1;
+  if (n > 0) {
+    std::mt19937 rng(5489);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::unordered_map<int, size_t> freq;
+    size_t best = 0;
+    for (size_t i = 0; i < sample_size; ++i) {
+      const int root = sets.find(pick(rng));
+      if (++freq[root] > best) {
+        best = freq[root];
+        giant = root;
+      }
     }
-    ebccs.push_back(component);
   }
+
+  const bool directed = cg.isDirected();
+  graphTest::parallelForBlocks(
+      n, num_threads, [&](size_t, size_t begin, size_t end) {
+        for (size_t u = begin; u < end; ++u) {
+          const int v = static_cast<int>(u);
+          if (sets.find(v) == giant) {
+            continue;
+          }
+          for (size_t a = cg.outBegin(v) + neighbor_rounds; a < cg.outEnd(v);
+               ++a) {
+            sets.merge(v, cg.outTargets()[a]);
+          }
+          if (directed) {
+            for (size_t a = cg.inBegin(v); a < cg.inEnd(v); ++a) {
+              sets.merge(v, cg.inSources()[a]);
+            }
+          }
+        }
+      });
+}
+
+template <typename DataT>
+void connectedComponentsAfforest(const graphTest::CompactGraph<DataT> &cg,
+                                 size_t num_threads,
+                                 graphTest::ComponentLabels<DataT> &res) {
+  graphTest::ConcurrentDisjointSets sets;
+  afforestLink(cg, num_threads, sets);
+  relabelComponents(cg, [&](int v) { return sets.find(v); }, res);
+}
+
+template <typename DataT>
+graphTest::ComponentLabels<DataT>
+connectedComponentLabels(const graphTest::CompactGraph<DataT> &cg,
+                         graphTest::CCAlgo algo, size_t num_threads) {
+  graphTest::ComponentLabels<DataT> res;
+  switch (algo) {
+  case graphTest::UnionFindCC:
+    connectedComponentsUnionFind(cg, res);
+    break;
+  case graphTest::Afforest:
+    connectedComponentsAfforest(cg, num_threads, res);
+    break;
+  default:
+    std::cerr << "Unknown algorithm" << std::endl;
+  }
+  return res;
 }
 
 } // namespace
 
 namespace graphTest {
+// Strongly connected components as a label array. Tarjan labels them in
+// reverse topological order (every component reachable from label c has a
+// smaller label), Kosaraju in topological order.
 template <typename DataT>
-std::vector<std::vector<typename Graph<DataT>::Pointer>>
-getSCC(const Graph<DataT> *graph, SCCAlgo algo) {
+ComponentLabels<DataT> getSCCLabels(const Graph<DataT> *graph, SCCAlgo algo,
+                                    TraversalWorkspace<DataT> &ws) {
   if (!graph) {
     std::cerr << "Graph is null pointer" << std::endl;
     return {};
   } else if (!graph->isDirected()) {
     std::cerr << "Graph is not directed" << std::endl;
     return {};
-  } else {
-    switch (algo) {
-    case Tarjan:
-      return getSCCTarjan(graph);
-    case Kosaraju:
-      return getSCCKosaraju(graph);
-    default:
-      std::cerr << "Unknown algorithm" << std::endl;
-      return {};
+  }
+  ws.bind(graph);
+  ComponentLabels<DataT> res;
+  switch (algo) {
+  case Tarjan:
+    sccLabelsTarjan(ws, res);
+    break;
+  case Kosaraju:
+    sccLabelsKosaraju(ws, res);
+    break;
+  default:
+    std::cerr << "Unknown algorithm" << std::endl;
+  }
+  return res;
+}
+
+template <typename DataT>
+ComponentLabels<DataT> getSCCLabels(const Graph<DataT> *graph, SCCAlgo algo) {
+  TraversalWorkspace<DataT> ws;
+  return getSCCLabels(graph, algo, ws);
+}
+
+template <typename DataT>
+std::vector<std::vector<typename Graph<DataT>::Pointer>>
+getSCC(const Graph<DataT> *graph, SCCAlgo algo, TraversalWorkspace<DataT> &ws) {
+  return getSCCLabels(graph, algo, ws).toGroups();
+}
+
+template <typename DataT>
+std::vector<std::vector<typename Graph<DataT>::Pointer>>
+getSCC(const Graph<DataT> *graph, SCCAlgo algo) {
+  TraversalWorkspace<DataT> ws;
+  return getSCC(graph, algo, ws);
+}
+
+// Connected components of an undirected graph as a label array, labels
+// numbered by their first vertex. Afforest runs on num_threads threads
+// (0: all hardware threads).
+template <typename DataT>
+ComponentLabels<DataT> getConnectedComponents(const Graph<DataT> *graph,
+                                              CCAlgo algo = UnionFindCC,
+                                              size_t num_threads = 0) {
+  if (!graph) {
+    std::cerr << "Graph is null pointer" << std::endl;
+    return {};
+  } else if (graph->isDirected()) {
+    std::cerr << "Graph is directed, use getWeaklyConnectedComponents"
+              << std::endl;
+    return {};
+  }
+  CompactGraph<DataT> cg(graph);
+  return connectedComponentLabels(cg, algo, num_threads);
+}
+
+// Weakly connected components: components of the graph with arc
+// directions ignored. An undirected graph gives its connected components.
+template <typename DataT>
+ComponentLabels<DataT>
+getWeaklyConnectedComponents(const CompactGraph<DataT> &cg,
+                             CCAlgo algo = UnionFindCC,
+                             size_t num_threads = 0) {
+  return connectedComponentLabels(cg, algo, num_threads);
+}
+
+template <typename DataT>
+ComponentLabels<DataT>
+getWeaklyConnectedComponents(const Graph<DataT> *graph,
+                             CCAlgo algo = UnionFindCC,
+                             size_t num_threads = 0) {
+  if (!graph) {
+    std::cerr << "Graph is null pointer" << std::endl;
+    return {};
+  }
+  CompactGraph<DataT> cg(graph);
+  return connectedComponentLabels(cg, algo, num_threads);
+}
+
+// Vertex-biconnected components in flat form; a cut vertex belongs to
+// several components.
+template <typename DataT>
+ComponentMembers<DataT>
+getBiConnectedVertexCCMembers(const Graph<DataT> *graph) {
+  if (!graph) {
+    std::cerr << "Graph is null pointer" << std::endl;
+    return {};
+  } else if (graph->isDirected()) {
+    std::cerr << "Graph is directed biConnected CC is for undirected graph"
+              << std::endl;
+    return {};
+  }
+  TraversalWorkspace<DataT> ws(graph);
+  ComponentMembers<DataT> res;
+  vbccMembers(ws, res);
+  return res;
+}
+
+// from this many arcs on isWeaklyConnected links with Afforest by default
+constexpr size_t kParallelWeakConnectivityArcs = size_t(1) << 20;
+
+// True if all vertexs of the workspace graph lie in one weakly connected
+// component, false for an empty graph. With ignore_isolated, vertexs
+// without any incident arc are left out. num_threads 1 traverses the
+// workspace graph with its own buffers, more threads link the arcs with
+// Afforest; 0 picks Afforest on all cores from
+// kParallelWeakConnectivityArcs arcs on.
+template <typename DataT>
+bool isWeaklyConnected(TraversalWorkspace<DataT> &ws, bool ignore_isolated,
+                       size_t num_threads = 0) {
+  const auto &cg = ws.graph();
+  const int n = static_cast<int>(cg.numVertexs());
+  auto counted = [&](int v) {
+    return !ignore_isolated || cg.inDegree(v) + cg.outDegree(v) > 0;
+  };
+  int first = -1;
+  size_t count = 0;
+  for (int v = 0; v < n; ++v) {
+    if (counted(v)) {
+      first = first == -1 ? v : first;
+      ++count;
+    }
+  }
+  if (count == 0) {
+    return false;
+  }
+  if (num_threads == 0 && cg.numArcs() < kParallelWeakConnectivityArcs) {
+    num_threads = 1;
+  }
+  if (num_threads == 1) {
+    return countReachable(ws, first, true, true) == count;
+  }
+  ConcurrentDisjointSets sets;
+  afforestLink(cg, num_threads, sets);
+  const int root = sets.find(first);
+  for (int v = 0; v < n; ++v) {
+    if (counted(v) && sets.find(v) != root) {
+      return false;
     }
   }
+  return true;
 }
 
 template <typename DataT>
 std::vector<std::vector<typename Graph<DataT>::Pointer>>
 getBiConnectedVertexCC(const Graph<DataT> *graph) {
+  return getBiConnectedVertexCCMembers(graph).toGroups();
+}
+
+// Edge-biconnected components as a label array: every vertex belongs to
+// exactly one of them.
+template <typename DataT>
+ComponentLabels<DataT> getBiConnectedEdgeCCLabels(const Graph<DataT> *graph) {
   if (!graph) {
     std::cerr << "Graph is null pointer" << std::endl;
     return {};
@@ -279,20 +653,15 @@ getBiConnectedVertexCC(const Graph<DataT> *graph) {
     std::cerr << "Graph is directed biConnected CC is for undirected graph"
               << std::endl;
     return {};
-  } else {
-    typedef typename Graph<DataT>::Pointer Pointer;
-    std::vector<std::vector<Pointer>> vbccs;
-    std::unordered_map<Pointer, int> dfn, low;
-    std::stack<Pointer> st;
-    int timer = 0;
-    for (Pointer v : graph->getAllVertexs()) {
-      if (dfn.find(v) == dfn.end())
-        tarjanVBCCDFS<DataT>(v, nullptr, graph, timer, dfn, low, st, vbccs);
-    }
-    return vbccs;
   }
+  TraversalWorkspace<DataT> ws(graph);
+  ComponentLabels<DataT> res;
+  ebccLabels(ws, res);
+  return res;
 }
 
+// Members of a component are listed in the order Tarjan pops them off its
+// stack, that is by decreasing discovery time.
 template <typename DataT>
 std::vector<std::vector<typename Graph<DataT>::Pointer>>
 getBiConnectedEdgeCC(const Graph<DataT> *graph) {
@@ -303,19 +672,22 @@ getBiConnectedEdgeCC(const Graph<DataT> *graph) {
     std::cerr << "Graph is directed biConnected CC is for undirected graph"
               << std::endl;
     return {};
-  } else {
-    typedef typename Graph<DataT>::Pointer Pointer;
-    std::vector<std::vector<Pointer>> ebccs;
-    std::unordered_map<Pointer, int> dfn, low;
-    std::stack<Pointer> st;
-    int timer = 0;
-    for (Pointer v : graph->getAllVertexs()) {
-      if (dfn.find(v) == dfn.end())
-        tarjanEBCCDFS<DataT>(v, nullptr, graph, timer, dfn, low, st, ebccs);
-    }
-    return ebccs;
   }
+  TraversalWorkspace<DataT> ws(graph);
+  ComponentLabels<DataT> labels;
+  ebccLabels(ws, labels);
+  std::vector<int> by_time(labels.vertexs.size());
+  for (size_t v = 0; v < by_time.size(); ++v) {
+    by_time[ws.value(static_cast<int>(v)) - 1] = static_cast<int>(v);
+  }
+  std::vector<std::vector<typename Graph<DataT>::Pointer>> groups(
+      labels.count);
+  for (auto it = by_time.rbegin(); it != by_time.rend(); ++it) {
+    groups[labels.label[*it]].push_back(labels.vertexs[*it]);
+  }
+  return groups;
 }
+
 template <typename DataT>
 BlockForestResult<DataT> getBlockForest(const Graph<DataT> *graph) {
   if (!graph) {
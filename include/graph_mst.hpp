@@ -1,105 +1,468 @@
 
 #pragma once
 #include "basicAlgo.hpp"
+#include "compact_graph.hpp"
 #include "graph.hpp"
+#include "parallel.hpp"
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <numeric>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 namespace graphTest {
+
+// Flat spanning forest: the selected edges of every tree in one vector.
+// Every edge of a DMST forest points from parent to child.
+template <typename T> struct SpanningForest {
+  std::vector<typename Graph<T>::Edge> edges;
+  long long weight = 0;
+
+  void add(const typename Graph<T>::Edge &e) {
+    edges.push_back(e);
+    weight += e.weight_;
+  }
+};
+
 namespace {
+// Splits a flat forest into one graph per tree, ordered by their first edge
+// in the forest. With edgeless_trees every other vertex of `graph` follows
+// as a one-vertex tree; without it, only trees with edges are returned.
 template <typename T>
-std::vector<std::unique_ptr<Graph<T>>> getMSTsKruskal(const Graph<T> *graph) {
-  auto edges = graph->getAllEdges();
-  std::sort(
-      edges.begin(), edges.end(),
-      [](const typename Graph<T>::Edge &a, const typename Graph<T>::Edge &b) {
-        return a.weight_ < b.weight_;
-      });
+std::vector<std::unique_ptr<Graph<T>>>
+forestToGraphs(const Graph<T> *graph, const SpanningForest<T> &forest,
+               bool directed, bool edgeless_trees) {
   UnionFind<T> uf;
-  std::unordered_map<typename Graph<T>::Pointer,
-                     std::vector<std::pair<typename Graph<T>::Pointer, int>>>
-      edge_map;
-  for (auto &e : edges) {
+  uf.reserve(graph->numVertexs());
+  for (const auto &e : forest.edges) {
     uf.add(e.from.get_data());
     uf.add(e.to.get_data());
-    if (uf.findParent(e.from.get_data()) != uf.findParent(e.to.get_data())) {
-      uf.merge(e.from.get_data(), e.to.get_data());
-      edge_map[e.from.get_data()].push_back({e.to.get_data(), e.weight_});
-      edge_map[e.to.get_data()].push_back({e.from.get_data(), e.weight_});
+  }
+  if (edgeless_trees) {
+    for (T *v : graph->getAllVertexs()) {
+      uf.add(v);
     }
   }
+  for (const auto &e : forest.edges) {
+    uf.merge(e.from.get_data(), e.to.get_data());
+  }
   auto groups = uf.getGroups();
-  std::vector<std::unique_ptr<Graph<T>>> mst_graphs;
-  for (const auto &pair : groups) {
-    const auto &group_nodes = pair.second;
-    std::unordered_set<T *> node_set(group_nodes.begin(), group_nodes.end());
-    auto mst_graph = std::make_unique<UnDirectedGraph<T>>();
-    for (const auto &node : group_nodes) {
-      for (auto p : edge_map[node]) {
-        if (node_set.count(p.first)) {
-          mst_graph->addEdge(node, p.first, p.second);
-        }
+  std::unordered_map<T *, size_t> tree_of;
+  tree_of.reserve(groups.size());
+  std::vector<std::unique_ptr<Graph<T>>> trees;
+  trees.reserve(groups.size());
+  for (size_t g = 0; g < groups.size(); ++g) {
+    tree_of[groups[g].first] = g;
+    std::unique_ptr<Graph<T>> tree;
+    if (directed) {
+      tree = std::make_unique<DirectedGraph<T>>();
+    } else {
+      tree = std::make_unique<UnDirectedGraph<T>>();
+    }
+    for (T *v : groups[g].second) {
+      tree->addVertex(v);
+    }
+    trees.push_back(std::move(tree));
+  }
+  for (const auto &e : forest.edges) {
+    trees[tree_of[uf.findParent(e.from.get_data())]]->addEdge(
+        e.from.get_data(), e.to.get_data(), e.weight_);
+  }
+  return trees;
+}
+
+// Undirected edge of a CompactGraph, stored once with u < v. The MST
+// algorithms on this list break weight ties by edge index, so they all
+// select exactly the same forest.
+struct MSTEdge {
+  int u;
+  int v;
+  int w;
+};
+
+template <typename T>
+void collectMSTEdges(const CompactGraph<T> &cg, std::vector<MSTEdge> &edges) {
+  edges.clear();
+  edges.reserve(cg.numArcs() / 2);
+  for (int u = 0; u < static_cast<int>(cg.numVertexs()); ++u) {
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      if (u < cg.outTargets()[a]) {
+        edges.push_back({u, cg.outTargets()[a], cg.outWeights()[a]});
+      }
+    }
+  }
+}
+
+// (weight, edge index) packed so that unsigned order is the tie-broken
+// weight order
+inline std::uint64_t mstEdgeKey(int w, std::uint32_t index) {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(w) ^
+                                     0x80000000u)
+          << 32) |
+         index;
+}
+
+inline std::uint32_t mstEdgeIndex(std::uint64_t key) {
+  return static_cast<std::uint32_t>(key);
+}
+
+template <typename T>
+void addMSTEdge(const CompactGraph<T> &cg, const MSTEdge &e,
+                SpanningForest<T> &forest) {
+  forest.add(typename Graph<T>::Edge(cg.vertexAt(e.u), cg.vertexAt(e.v), e.w));
+}
+
+// LSD radix sort of packed edge keys, one byte per pass. A single counting
+// pass builds all eight histograms, and bytes that are equal in every key
+// are skipped, so weights in a small range cost few passes.
+inline void radixSortKeys(std::uint64_t *first, std::uint64_t *last,
+                          std::vector<std::uint64_t> &scratch) {
+  const size_t n = static_cast<size_t>(last - first);
+  if (n < 64) {
+    std::sort(first, last);
+    return;
+  }
+  std::vector<size_t> count(8 * 256, 0);
+  for (size_t i = 0; i < n; ++i) {
+    for (int b = 0; b < 8; ++b) {
+      ++count[b * 256 + ((first[i] >> (8 * b)) & 0xff)];
+    }
+  }
+  scratch.resize(n);
+  std::uint64_t *src = first;
+  std::uint64_t *dst = scratch.data();
+  for (int b = 0; b < 8; ++b) {
+    size_t *c = count.data() + b * 256;
+    if (c[(first[0] >> (8 * b)) & 0xff] == n) {
+      continue; // every key has the same byte here
+    }
+    size_t sum = 0;
+    for (int d = 0; d < 256; ++d) {
+      const size_t cnt = c[d];
+      c[d] = sum;
+      sum += cnt;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      dst[c[(src[i] >> (8 * b)) & 0xff]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != first) {
+    std::copy(src, src + n, first);
+  }
+}
+
+template <typename T> SpanningForest<T> getMSTKruskal(const Graph<T> *graph) {
+  CompactGraph<T> cg(graph);
+  std::vector<MSTEdge> edges;
+  collectMSTEdges(cg, edges);
+  std::vector<std::uint64_t> keys(edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    keys[i] = mstEdgeKey(edges[i].w, static_cast<std::uint32_t>(i));
+  }
+  std::vector<std::uint64_t> scratch;
+  radixSortKeys(keys.data(), keys.data() + keys.size(), scratch);
+  DisjointSets sets(cg.numVertexs());
+  SpanningForest<T> forest;
+  for (std::uint64_t key : keys) {
+    const MSTEdge &e = edges[mstEdgeIndex(key)];
+    if (sets.merge(e.u, e.v)) {
+      addMSTEdge(cg, e, forest);
+    }
+  }
+  return forest;
+}
+
+// Filter-Kruskal (Osipov, Sanders, Singler). Keys at most the pivot are
+// handled first; the heavier keys are then filtered down to the edges that
+// still join two components before they are partitioned or sorted. On
+// graphs whose forest is settled by light edges most heavy edges are
+// dropped without being sorted.
+template <typename T>
+void filterKruskal(const CompactGraph<T> &cg, const std::vector<MSTEdge> &edges,
+                   std::uint64_t *first, std::uint64_t *last,
+                   DisjointSets &sets, std::vector<std::uint64_t> &scratch,
+                   SpanningForest<T> &forest) {
+  const size_t base_size = 1024;
+  if (static_cast<size_t>(last - first) <= base_size) {
+    radixSortKeys(first, last, scratch);
+    for (std::uint64_t *k = first; k != last; ++k) {
+      const MSTEdge &e = edges[mstEdgeIndex(*k)];
+      if (sets.merge(e.u, e.v)) {
+        addMSTEdge(cg, e, forest);
       }
     }
-    mst_graphs.push_back(std::move(mst_graph));
+    return;
   }
-  return mst_graphs;
+  // median of three, keys are distinct so both halves are never empty
+  const size_t n = static_cast<size_t>(last - first);
+  std::uint64_t a = first[0], b = first[n / 2], c = first[n - 1];
+  const std::uint64_t pivot =
+      std::max(std::min(a, b), std::min(std::max(a, b), c));
+  std::uint64_t *mid = std::partition(
+      first, last, [pivot](std::uint64_t k) { return k <= pivot; });
+  filterKruskal(cg, edges, first, mid, sets, scratch, forest);
+  std::uint64_t *kept = std::partition(mid, last, [&](std::uint64_t k) {
+    const MSTEdge &e = edges[mstEdgeIndex(k)];
+    return !sets.same(e.u, e.v);
+  });
+  filterKruskal(cg, edges, mid, kept, sets, scratch, forest);
 }
 
 template <typename T>
-std::vector<std::unique_ptr<Graph<T>>> getMSTsPrim(const Graph<T> *graph) {
-  std::unordered_set<T *> unvisited;
-  for (const auto &v : graph->getAllVertexs()) {
-    unvisited.insert(v);
-  }
-  std::vector<std::unique_ptr<Graph<T>>> mst_graphs;
-  while (!unvisited.empty()) {
-    auto mst_graph = std::make_unique<UnDirectedGraph<T>>();
-    T *start_node = *unvisited.begin();
-    mst_graph->addVertex(start_node);
-    unvisited.erase(start_node);
-    using EdgeType = typename Graph<T>::Edge;
-    auto cmp = [](const EdgeType &a, const EdgeType &b) {
-      return a.weight_ > b.weight_;
+SpanningForest<T> getMSTFilterKruskal(const Graph<T> *graph) {
+  CompactGraph<T> cg(graph);
+  std::vector<MSTEdge> edges;
+  collectMSTEdges(cg, edges);
+  std::vector<std::uint64_t> keys(edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    keys[i] = mstEdgeKey(edges[i].w, static_cast<std::uint32_t>(i));
+  }
+  DisjointSets sets(cg.numVertexs());
+  std::vector<std::uint64_t> scratch;
+  SpanningForest<T> forest;
+  filterKruskal(cg, edges, keys.data(), keys.data() + keys.size(), sets,
+                scratch, forest);
+  return forest;
+}
+
+inline void atomicMinKey(std::atomic<std::uint64_t> &slot, std::uint64_t key) {
+  std::uint64_t cur = slot.load(std::memory_order_relaxed);
+  while (key < cur &&
+         !slot.compare_exchange_weak(cur, key, std::memory_order_relaxed)) {
+  }
+}
+
+// Parallel Boruvka on ConcurrentDisjointSets. Every round each component
+// picks its lightest outgoing edge (atomic min on the packed key) and the
+// picked edges are merged; edges inside one component are dropped. With
+// the tie-broken order the picked edges never form a cycle, so the result
+// is the forest Kruskal selects. With kruskal_tail set, the rounds stop
+// once the components shrank to an eighth and the remaining edges, which
+// all cross components, are finished by Kruskal.
+template <typename T>
+SpanningForest<T> getMSTBoruvka(const Graph<T> *graph, size_t num_threads,
+                                bool kruskal_tail) {
+  CompactGraph<T> cg(graph);
+  std::vector<MSTEdge> edges;
+  collectMSTEdges(cg, edges);
+  const size_t n = cg.numVertexs();
+  if (num_threads == 0) {
+    num_threads = defaultThreadCount();
+  }
+  const std::uint64_t none = ~std::uint64_t(0);
+  ConcurrentDisjointSets sets(n);
+  std::vector<std::atomic<std::uint64_t>> best(n);
+  std::vector<std::uint32_t> active(edges.size());
+  std::iota(active.begin(), active.end(), 0);
+  std::vector<std::uint32_t> next_active;
+  std::vector<std::vector<std::uint32_t>> picked(num_threads);
+  std::vector<size_t> block_count(num_threads + 1);
+  size_t components = n;
+
+  while (!active.empty()) {
+    if (kruskal_tail && components * 8 <= n) {
+      break;
+    }
+    parallelForBlocks(n, num_threads, [&](size_t, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        best[v].store(none, std::memory_order_relaxed);
+      }
+    });
+    parallelForBlocks(
+        active.size(), num_threads, [&](size_t, size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i) {
+            const MSTEdge &e = edges[active[i]];
+            const int ru = sets.find(e.u);
+            const int rv = sets.find(e.v);
+            const std::uint64_t key = mstEdgeKey(e.w, active[i]);
+            atomicMinKey(best[ru], key);
+            atomicMinKey(best[rv], key);
+          }
+        });
+    parallelForBlocks(n, num_threads, [&](size_t t, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        const std::uint64_t key = best[v].load(std::memory_order_relaxed);
+        if (key == none) {
+          continue;
+        }
+        const MSTEdge &e = edges[mstEdgeIndex(key)];
+        // both ends may pick the same edge, only one merge succeeds
+        if (sets.merge(e.u, e.v)) {
+          picked[t].push_back(mstEdgeIndex(key));
+        }
+      }
+    });
+    size_t merged = 0;
+    for (const auto &p : picked) {
+      merged += p.size();
+    }
+    if (merged == n - components) {
+      break; // nothing merged this round
+    }
+    components = n - merged;
+
+    // keep the edges that still cross components: count per block, then
+    // copy into place
+    const size_t blocks = std::min(num_threads, active.size());
+    auto crossing = [&](std::uint32_t i) {
+      return sets.find(edges[i].u) != sets.find(edges[i].v);
     };
-    std::priority_queue<EdgeType, std::vector<EdgeType>, decltype(cmp)> edge_pq(
-        cmp);
-    std::vector<EdgeType> edges;
-    graph->getOutEdges(start_node, edges);
-    for (const auto &e : edges) {
-      edge_pq.push(e);
-    }
-    while (!edge_pq.empty()) {
-      auto cur_edge = edge_pq.top();
-      edge_pq.pop();
-      T *to_node = cur_edge.to.get_data();
-      if (unvisited.count(to_node) == 0) {
+    parallelForBlocks(
+        active.size(), num_threads, [&](size_t t, size_t begin, size_t end) {
+          size_t count = 0;
+          for (size_t i = begin; i < end; ++i) {
+            count += crossing(active[i]) ? 1 : 0;
+          }
+          block_count[t + 1] = count;
+        });
+    block_count[0] = 0;
+    for (size_t t = 0; t < blocks; ++t) {
+      block_count[t + 1] += block_count[t];
+    }
+    next_active.resize(block_count[blocks]);
+    parallelForBlocks(
+        active.size(), num_threads, [&](size_t t, size_t begin, size_t end) {
+          size_t pos = block_count[t];
+          for (size_t i = begin; i < end; ++i) {
+            if (crossing(active[i])) {
+              next_active[pos++] = active[i];
+            }
+          }
+        });
+    active.swap(next_active);
+  }
+
+  std::vector<std::uint64_t> keys;
+  for (const auto &p : picked) {
+    for (std::uint32_t i : p) {
+      keys.push_back(mstEdgeKey(edges[i].w, i));
+    }
+  }
+  if (kruskal_tail) {
+    std::vector<std::uint64_t> tail(active.size());
+    for (size_t i = 0; i < active.size(); ++i) {
+      tail[i] = mstEdgeKey(edges[active[i]].w, active[i]);
+    }
+    std::sort(tail.begin(), tail.end());
+    for (std::uint64_t key : tail) {
+      const MSTEdge &e = edges[mstEdgeIndex(key)];
+      if (sets.merge(e.u, e.v)) {
+        keys.push_back(key);
+      }
+    }
+  }
+  // report the edges in Kruskal order
+  std::sort(keys.begin(), keys.end());
+  SpanningForest<T> forest;
+  for (std::uint64_t key : keys) {
+    addMSTEdge(cg, edges[mstEdgeIndex(key)], forest);
+  }
+  return forest;
+}
+
+// Prim on the CSR snapshot. Every vertex outside the tree keeps only its
+// lightest connecting arc as a packed (weight, arc) key, so the heap holds
+// at most one entry per vertex and is updated by decrease-key. For dense
+// graphs a plain O(V^2) scan over these keys replaces the heap.
+template <typename T>
+SpanningForest<T> getMSTPrim(const Graph<T> *graph) {
+  CompactGraph<T> cg(graph);
+  const int n = static_cast<int>(cg.numVertexs());
+  const auto &targets = cg.outTargets();
+  const auto &weights = cg.outWeights();
+  const std::uint64_t none = ~std::uint64_t(0);
+  std::vector<char> in_tree(n, 0);
+  std::vector<int> arc_source(n, -1);
+  // (key, tree vertex) of every tree arc, reported in key order like the
+  // Kruskal forest
+  std::vector<std::pair<std::uint64_t, int>> tree_arcs;
+  tree_arcs.reserve(n);
+  auto addTreeArc = [&](int v, std::uint64_t key) {
+    tree_arcs.push_back({key, arc_source[v]});
+  };
+  auto toForest = [&]() {
+    std::sort(tree_arcs.begin(), tree_arcs.end());
+    SpanningForest<T> forest;
+    for (const auto &t : tree_arcs) {
+      const size_t arc = mstEdgeIndex(t.first);
+      forest.add(typename Graph<T>::Edge(cg.vertexAt(t.second),
+                                         cg.vertexAt(targets[arc]),
+                                         weights[arc]));
+    }
+    return forest;
+  };
+
+  const bool dense = static_cast<double>(cg.numArcs()) >=
+                     0.25 * static_cast<double>(n) * static_cast<double>(n);
+  if (dense) {
+    std::vector<std::uint64_t> best(n, none);
+    for (int root = 0; root < n; ++root) {
+      if (in_tree[root]) {
         continue;
       }
-      // add edge to mst
-      mst_graph->addEdge(cur_edge.from.get_data(), to_node, cur_edge.weight_);
-      unvisited.erase(to_node);
-      // add new edges
-      graph->getOutEdges(to_node, edges);
-      for (const auto &e : edges) {
-        if (unvisited.count(e.to.get_data()) > 0) {
-          edge_pq.push(e);
+      int u = root;
+      while (u != -1) {
+        in_tree[u] = 1;
+        if (u != root) {
+          addTreeArc(u, best[u]);
+        }
+        for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+          const int v = targets[a];
+          const std::uint64_t key =
+              mstEdgeKey(weights[a], static_cast<std::uint32_t>(a));
+          if (!in_tree[v] && key < best[v]) {
+            best[v] = key;
+            arc_source[v] = u;
+          }
+        }
+        u = -1;
+        std::uint64_t min_key = none;
+        for (int v = 0; v < n; ++v) {
+          if (!in_tree[v] && best[v] < min_key) {
+            min_key = best[v];
+            u = v;
+          }
         }
       }
     }
-    mst_graphs.push_back(std::move(mst_graph));
+    return toForest();
   }
-  return mst_graphs;
+
+  IndexedHeap<std::uint64_t> heap(n);
+  for (int root = 0; root < n; ++root) {
+    if (in_tree[root]) {
+      continue;
+    }
+    in_tree[root] = 1;
+    int u = root;
+    while (true) {
+      for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+        const int v = targets[a];
+        if (!in_tree[v] &&
+            heap.pushOrDecrease(
+                v, mstEdgeKey(weights[a], static_cast<std::uint32_t>(a)))) {
+          arc_source[v] = u;
+        }
+      }
+      if (heap.empty()) {
+        break;
+      }
+      u = heap.top();
+      addTreeArc(u, heap.key(u));
+      heap.pop();
+      in_tree[u] = 1;
+    }
+  }
+  return toForest();
 }
 
-template <typename T>
-std::vector<std::unique_ptr<Graph<T>>> getDMSTsZhuLiu(const Graph<T> *graph) {
+template <typename T> SpanningForest<T> getDMSTZhuLiu(const Graph<T> *graph) {
   using Vertex = typename Graph<T>::Pointer;
   auto vs = graph->getAllVertexs();
   if (vs.empty())
@@ -249,36 +612,13 @@ std::vector<std::unique_ptr<Graph<T>>> getDMSTsZhuLiu(const Graph<T> *graph) {
       forest_edges.push_back(e);
   }
 
-  // 5. 【修正】UnionFind 正确姿势：传 T* 指针
-  UnionFind<T> uf;
-  for (int i = 0; i < n; ++i)
-    uf.add(vs[i]);
-  for (auto &e : forest_edges)
-    uf.merge(vs[e.u], vs[e.v]);
-
-  auto groups = uf.getGroups(); // map<T*, vector<T*>>
-  std::vector<std::unique_ptr<Graph<T>>> results;
-
-  for (auto &pair : groups) {
-    auto dmst = std::make_unique<DirectedGraph<T>>();
-    std::unordered_set<Vertex> group_nodes(pair.second.begin(),
-                                           pair.second.end());
-
-    for (auto &e : forest_edges) {
-      if (group_nodes.count(vs[e.v])) {
-        dmst->addEdge(vs[e.u], vs[e.v], e.w);
-      }
-    }
-    // 保证孤立点也在里面
-    for (Vertex node : pair.second)
-      dmst->addVertex(node);
-    results.push_back(std::move(dmst));
+  SpanningForest<T> forest;
+  for (auto &e : forest_edges) {
+    forest.add(typename Graph<T>::Edge(vs[e.u], vs[e.v], e.w));
   }
-
-  return results;
+  return forest;
 }
-template <typename T>
-std::vector<std::unique_ptr<Graph<T>>> getDMSTsTarjan(const Graph<T> *graph) {
+template <typename T> SpanningForest<T> getDMSTTarjan(const Graph<T> *graph) {
   using Vertex = typename Graph<T>::Pointer;
   auto vs = graph->getAllVertexs();
   if (vs.empty())
@@ -445,31 +785,11 @@ std::vector<std::unique_ptr<Graph<T>>> getDMSTsTarjan(const Graph<T> *graph) {
             {e.orig_u, e.orig_v, adj[vs[e.orig_u]][vs[e.orig_v]]});
       }
 
-      UnionFind<T> uf;
-      for (int i = 0; i < n; ++i) {
-        uf.add(vs[i]);
-      }
+      SpanningForest<T> forest;
       for (const auto &e : forest_edges) {
-        uf.merge(vs[e.u], vs[e.v]);
-      }
-
-      auto groups_map = uf.getGroups();
-      std::vector<std::unique_ptr<Graph<T>>> results;
-      for (auto &pair : groups_map) {
-        auto dmst = std::make_unique<DirectedGraph<T>>();
-        std::unordered_set<Vertex> group_nodes(pair.second.begin(),
-                                               pair.second.end());
-        for (const auto &e : forest_edges) {
-          if (group_nodes.count(vs[e.v])) {
-            dmst->addEdge(vs[e.u], vs[e.v], e.w);
-          }
-        }
-        for (Vertex node : pair.second) {
-          dmst->addVertex(node);
-        }
-        results.push_back(std::move(dmst));
+        forest.add(typename Graph<T>::Edge(vs[e.u], vs[e.v], e.w));
       }
-      return results;
+      return forest;
     }
 
     // 第三步：把每个环压成一个超点，非环点各自作为单独的组。
@@ -507,15 +827,249 @@ std::vector<std::unique_ptr<Graph<T>>> getDMSTsTarjan(const Graph<T> *graph) {
   }
 }
 
+// Disjoint sets with union by size and no path compression, so merges can
+// be undone in reverse order back to an earlier time().
+class RollbackDisjointSets {
+public:
+  explicit RollbackDisjointSets(size_t n) : parent_(n, -1) {}
+
+  int find(int x) const {
+    while (parent_[x] >= 0) {
+      x = parent_[x];
+    }
+    return x;
+  }
+
+  size_t time() const { return history_.size(); }
+
+  void rollback(size_t t) {
+    while (history_.size() > t) {
+      parent_[history_.back().first] = history_.back().second;
+      history_.pop_back();
+    }
+  }
+
+  bool merge(int a, int b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) {
+      return false;
+    }
+    if (parent_[a] > parent_[b]) {
+      std::swap(a, b);
+    }
+    history_.push_back({a, parent_[a]});
+    history_.push_back({b, parent_[b]});
+    parent_[a] += parent_[b];
+    parent_[b] = a;
+    return true;
+  }
+
+private:
+  // negative size for roots, parent otherwise
+  std::vector<int> parent_;
+  std::vector<std::pair<int, int>> history_;
+};
+
+// Leftist min-heaps of arcs with a lazy weight offset per node. The right
+// spine of a leftist heap has O(log n) nodes, which bounds both merge cost
+// and recursion depth.
+class ArcHeaps {
+public:
+  explicit ArcHeaps(size_t num_arcs) { nodes_.reserve(num_arcs); }
+
+  int make(long long w, int arc) {
+    nodes_.push_back({w, 0, arc, -1, -1, 1});
+    return static_cast<int>(nodes_.size()) - 1;
+  }
+
+  int merge(int a, int b) {
+    if (a < 0 || b < 0) {
+      return a < 0 ? b : a;
+    }
+    push(a);
+    push(b);
+    if (nodes_[b].w < nodes_[a].w) {
+      std::swap(a, b);
+    }
+    const int right = merge(nodes_[a].right, b);
+    nodes_[a].right = right;
+    if (rank(nodes_[a].left) < rank(right)) {
+      std::swap(nodes_[a].left, nodes_[a].right);
+    }
+    nodes_[a].rank = rank(nodes_[a].right) + 1;
+    return a;
+  }
+
+  long long topWeight(int h) {
+    push(h);
+    return nodes_[h].w;
+  }
+  int topArc(int h) const { return nodes_[h].arc; }
+  void addToAll(int h, long long delta) { nodes_[h].delta += delta; }
+  int pop(int h) {
+    push(h);
+    return merge(nodes_[h].left, nodes_[h].right);
+  }
+
+private:
+  struct Node {
+    long long w;
+    long long delta;
+    int arc;
+    int left;
+    int right;
+    int rank;
+  };
+
+  int rank(int h) const { return h < 0 ? 0 : nodes_[h].rank; }
+
+  void push(int h) {
+    Node &node = nodes_[h];
+    if (node.delta != 0) {
+      node.w += node.delta;
+      if (node.left >= 0) {
+        nodes_[node.left].delta += node.delta;
+      }
+      if (node.right >= 0) {
+        nodes_[node.right].delta += node.delta;
+      }
+      node.delta = 0;
+    }
+  }
+
+  std::vector<Node> nodes_;
+};
+
+// Minimum arborescence in O(E log V) (Gabow, Galil, Spencer, Tarjan). Every
+// vertex keeps its in-arcs in a mergeable heap. Walking from each vertex
+// along cheapest in-arcs either reaches a finished part or closes a cycle,
+// which is contracted by merging the heaps of its vertexs after subtracting
+// the chosen arc weight from each. The contractions are then undone in
+// reverse to pick the arc that enters every vertex. As in the other DMST
+// algorithms a virtual root with expensive arcs to every vertex turns the
+// result into a forest with as few trees as possible.
+template <typename T> SpanningForest<T> getDMSTGabow(const Graph<T> *graph) {
+  CompactGraph<T> cg(graph);
+  const int n = static_cast<int>(cg.numVertexs());
+  if (n == 0) {
+    return {};
+  }
+  const auto &targets = cg.outTargets();
+  const auto &weights = cg.outWeights();
+  // arcs 0..numArcs()-1 are the graph arcs, then one virtual arc per vertex
+  const int num_real = static_cast<int>(cg.numArcs());
+  std::vector<int> arc_from(num_real + n);
+  std::vector<int> arc_to(num_real + n);
+  long long weight_sum = 0;
+  for (int u = 0; u < n; ++u) {
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      arc_from[a] = u;
+      arc_to[a] = targets[a];
+      weight_sum += std::abs(static_cast<long long>(weights[a]));
+    }
+  }
+  const int root = n;
+  const long long virtual_w = weight_sum + 7;
+  for (int i = 0; i < n; ++i) {
+    arc_from[num_real + i] = root;
+    arc_to[num_real + i] = i;
+  }
+
+  const int num_v = n + 1;
+  ArcHeaps heaps(num_real + n);
+  std::vector<int> heap(num_v, -1);
+  for (int a = 0; a < num_real + n; ++a) {
+    if (arc_from[a] == arc_to[a]) {
+      continue;
+    }
+    const long long w = a < num_real ? weights[a] : virtual_w;
+    heap[arc_to[a]] = heaps.merge(heap[arc_to[a]], heaps.make(w, a));
+  }
+
+  RollbackDisjointSets sets(num_v);
+  std::vector<int> seen(num_v, -1);
+  std::vector<int> path(num_v);
+  std::vector<int> path_arc(num_v);
+  std::vector<int> in_arc(num_v, -1);
+  struct Cycle {
+    int vertex;
+    size_t time;
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Cycle> cycles;
+  std::vector<int> cycle_arcs;
+  seen[root] = root;
+  for (int s = 0; s < num_v; ++s) {
+    int u = s;
+    int len = 0;
+    while (seen[u] < 0) {
+      // every vertex has its virtual in-arc, so the heap is never empty
+      const int a = heaps.topArc(heap[u]);
+      heaps.addToAll(heap[u], -heaps.topWeight(heap[u]));
+      heap[u] = heaps.pop(heap[u]);
+      path[len] = u;
+      path_arc[len++] = a;
+      seen[u] = s;
+      u = sets.find(arc_from[a]);
+      if (seen[u] == s) {
+        // contract the cycle on the path into one vertex
+        int cyc = -1;
+        const int end = len;
+        const size_t time = sets.time();
+        int w;
+        do {
+          w = path[--len];
+          cyc = heaps.merge(cyc, heap[w]);
+        } while (sets.merge(u, w));
+        u = sets.find(u);
+        heap[u] = cyc;
+        seen[u] = -1;
+        cycles.push_back({u, time, cycle_arcs.size(),
+                          cycle_arcs.size() + (end - len)});
+        cycle_arcs.insert(cycle_arcs.end(), path_arc.begin() + len,
+                          path_arc.begin() + end);
+      }
+    }
+    for (int i = 0; i < len; ++i) {
+      in_arc[sets.find(arc_to[path_arc[i]])] = path_arc[i];
+    }
+  }
+  // expand the cycles, newest first
+  for (size_t c = cycles.size(); c-- > 0;) {
+    const Cycle &cycle = cycles[c];
+    sets.rollback(cycle.time);
+    const int enter = in_arc[cycle.vertex];
+    for (size_t i = cycle.begin; i < cycle.end; ++i) {
+      in_arc[sets.find(arc_to[cycle_arcs[i]])] = cycle_arcs[i];
+    }
+    in_arc[sets.find(arc_to[enter])] = enter;
+  }
+
+  SpanningForest<T> forest;
+  for (int v = 0; v < n; ++v) {
+    const int a = in_arc[v];
+    if (a >= 0 && a < num_real) {
+      forest.add(typename Graph<T>::Edge(cg.vertexAt(arc_from[a]),
+                                         cg.vertexAt(v), weights[a]));
+    }
+  }
+  return forest;
+}
+
 } // namespace
-enum MSTAlgo { KRUSKAL, PRIM };
-// If the graph is not connected, this function returns a Minimum Spanning
-// Forest (MSF) represented as a collection of MSTs for each connected
-// component.
+// BORUVKA runs parallel Boruvka rounds to the end, BORUVKA_KRUSKAL switches
+// to Kruskal on the remaining edges once few components are left.
+// FILTER_KRUSKAL skips sorting edges that already lie inside a component.
+// The Kruskal and Boruvka variants break weight ties the same way and return
+// the same forest; PRIM returns a forest of the same weight.
+enum MSTAlgo { KRUSKAL, PRIM, BORUVKA, BORUVKA_KRUSKAL, FILTER_KRUSKAL };
+// Minimum spanning forest as a flat edge list. num_threads is used by the
+// Boruvka variants, 0 means hardware concurrency.
 template <typename T>
-std::vector<std::unique_ptr<Graph<T>>> getMSTs(const Graph<T> *graph,
-                                               MSTAlgo algo = KRUSKAL) {
-
+SpanningForest<T> getMSTForest(const Graph<T> *graph, MSTAlgo algo = KRUSKAL,
+                               size_t num_threads = 0) {
   if (graph == nullptr) {
     std::cerr << "input graph is nullptr" << std::endl;
     return {};
@@ -526,30 +1080,79 @@ std::vector<std::unique_ptr<Graph<T>>> getMSTs(const Graph<T> *graph,
   }
   switch (algo) {
   case KRUSKAL:
-    return getMSTsKruskal<T>(graph);
+    return getMSTKruskal<T>(graph);
   case PRIM:
-    return getMSTsPrim<T>(graph);
+    return getMSTPrim<T>(graph);
+  case BORUVKA:
+    return getMSTBoruvka<T>(graph, num_threads, false);
+  case BORUVKA_KRUSKAL:
+    return getMSTBoruvka<T>(graph, num_threads, true);
+  case FILTER_KRUSKAL:
+    return getMSTFilterKruskal<T>(graph);
   }
   return {};
 }
 
-enum DMSTAlgo { ZHULIU, TARJAN };
+// If the graph is not connected, this function returns a Minimum Spanning
+// Forest (MSF) represented as a collection of MSTs for each connected
+// component.
 template <typename T>
-std::vector<std::unique_ptr<Graph<T>>> getDMSTs(const Graph<T> *graph,
-                                                DMSTAlgo algo) {
+std::vector<std::unique_ptr<Graph<T>>> getMSTs(const Graph<T> *graph,
+                                               MSTAlgo algo = KRUSKAL,
+                                               size_t num_threads = 0) {
+  if (graph == nullptr) {
+    std::cerr << "input graph is nullptr" << std::endl;
+    return {};
+  }
+  if (graph->isDirected()) {
+    std::cerr << "MST only applies to undirected graph" << std::endl;
+    return {};
+  }
+  // PRIM grows a tree from every vertex, the edge based algorithms only
+  // return trees that have edges
+  return forestToGraphs(graph, getMSTForest(graph, algo, num_threads), false,
+                        algo == PRIM);
+}
+
+// GABOW contracts cycles on mergeable heaps in O(E log V); ZHULIU and
+// TARJAN rescan every arc per contraction round.
+enum DMSTAlgo { ZHULIU, TARJAN, GABOW };
+// Minimum spanning arborescence forest as a flat edge list.
+template <typename T>
+SpanningForest<T> getDMSTForest(const Graph<T> *graph, DMSTAlgo algo) {
+  if (graph == nullptr) {
+    std::cerr << "input graph is nullptr" << std::endl;
+    return {};
+  }
   if (!graph->isDirected()) {
     std::cerr << "DMST only applies to directed graph" << std::endl;
     return {};
   }
   switch (algo) {
   case ZHULIU:
-    return getDMSTsZhuLiu<T>(graph);
+    return getDMSTZhuLiu<T>(graph);
   case TARJAN:
-    return getDMSTsTarjan<T>(graph);
+    return getDMSTTarjan<T>(graph);
+  case GABOW:
+    return getDMSTGabow<T>(graph);
   default:
     std::cerr << "unknown DMST algo" << std::endl;
     return {};
   }
 }
 
-} // namespace graphTest
\ No newline at end of file
+template <typename T>
+std::vector<std::unique_ptr<Graph<T>>> getDMSTs(const Graph<T> *graph,
+                                                DMSTAlgo algo) {
+  if (graph == nullptr) {
+    std::cerr << "input graph is nullptr" << std::endl;
+    return {};
+  }
+  if (!graph->isDirected()) {
+    std::cerr << "DMST only applies to directed graph" << std::endl;
+    return {};
+  }
+  return forestToGraphs(graph, getDMSTForest(graph, algo), true, true);
+}
+
+} // namespace graphTest
@@ -0,0 +1,627 @@
+#pragma once
+#include "compact_graph.hpp"
+#include "graph.hpp"
+#include "graph_connected_component.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+namespace gt = graphTest;
+
+// Level-synchronous bidirectional BFS: the forward search follows out-arcs
+// from s, the backward search follows in-arcs from t, and the smaller
+// frontier is always expanded next. Because whole levels are expanded, the
+// first vertex discovered by both sides already closes a shortest s-t path.
+// `fwd`/`bwd` expose get(node) (-1 when unvisited) and set(node, hops);
+// forEachOut/forEachIn call a functor on every neighbor of a node.
+template <typename Node, typename VisitMap, typename ForEachOut,
+          typename ForEachIn>
+int bidirectionalHops(Node s, Node t, VisitMap &fwd, VisitMap &bwd,
+                      std::vector<Node> &fwd_frontier,
+                      std::vector<Node> &bwd_frontier, std::vector<Node> &next,
+                      const ForEachOut &forEachOut,
+                      const ForEachIn &forEachIn) {
+  if (s == t) {
+    return 0;
+  }
+  fwd_frontier.clear();
+  bwd_frontier.clear();
+  fwd.set(s, 0);
+  bwd.set(t, 0);
+  fwd_frontier.push_back(s);
+  bwd_frontier.push_back(t);
+
+  while (!fwd_frontier.empty() && !bwd_frontier.empty()) {
+    const bool forward = fwd_frontier.size() <= bwd_frontier.size();
+    std::vector<Node> &frontier = forward ? fwd_frontier : bwd_frontier;
+    VisitMap &mine = forward ? fwd : bwd;
+    VisitMap &other = forward ? bwd : fwd;
+    int meet = -1;
+    next.clear();
+    for (Node u : frontier) {
+      const int du = mine.get(u);
+      auto relax = [&](Node v) {
+        if (meet != -1 || mine.get(v) != -1) {
+          return;
+        }
+        const int dv_other = other.get(v);
+        if (dv_other != -1) {
+          meet = du + 1 + dv_other;
+          return;
+        }
+        mine.set(v, du + 1);
+        next.push_back(v);
+      };
+      if (forward) {
+        forEachOut(u, relax);
+      } else {
+        forEachIn(u, relax);
+      }
+      if (meet != -1) {
+        return meet;
+      }
+    }
+    frontier.swap(next);
+  }
+  return -1;
+}
+
+template <typename DataT> struct PointerVisitMap {
+  using Pointer = typename gt::Graph<DataT>::Pointer;
+  std::unordered_map<Pointer, int> hops;
+  int get(Pointer p) const {
+    auto it = hops.find(p);
+    return it == hops.end() ? -1 : it->second;
+  }
+  void set(Pointer p, int h) { hops[p] = h; }
+};
+
+template <typename DataT>
+int hopDistanceOnGraph(const gt::Graph<DataT> *g,
+                       typename gt::Graph<DataT>::Pointer s,
+                       typename gt::Graph<DataT>::Pointer t) {
+  using Pointer = typename gt::Graph<DataT>::Pointer;
+  using Edge = typename gt::Graph<DataT>::Edge;
+  PointerVisitMap<DataT> fwd, bwd;
+  std::vector<Pointer> fwd_frontier, bwd_frontier, next;
+  std::vector<Edge> edges;
+  auto forEachOut = [&](Pointer u, const auto &fn) {
+    g->getOutEdges(u, edges);
+    for (const auto &e : edges) {
+      fn(e.to.get_data());
+    }
+  };
+  auto forEachIn = [&](Pointer v, const auto &fn) {
+    g->getInEdges(v, edges);
+    for (const auto &e : edges) {
+      fn(e.from.get_data());
+    }
+  };
+  return bidirectionalHops<Pointer>(s, t, fwd, bwd, fwd_frontier,
+                                    bwd_frontier, next, forEachOut, forEachIn);
+}
+
+template <typename DataT>
+bool checkReachabilityInput(const gt::Graph<DataT> *g,
+                            typename gt::Graph<DataT>::Pointer s,
+                            typename gt::Graph<DataT>::Pointer t) {
+  if (g == nullptr) {
+    std::cerr << "input graph is nullptr" << std::endl;
+    return false;
+  }
+  if (s == nullptr || t == nullptr) {
+    std::cerr << "source or target is nullptr" << std::endl;
+    return false;
+  }
+  // getIndegrees returns -1 for unknown vertices
+  return g->getIndegrees(s) >= 0 && g->getIndegrees(t) >= 0;
+}
+} // namespace
+
+namespace graphTest {
+
+// Number of edges on a shortest s->t path, or -1 if t is not reachable.
+// Only the part of the graph between s and t is explored.
+template <typename DataT>
+int hopDistance(const Graph<DataT> *g, typename Graph<DataT>::Pointer s,
+                typename Graph<DataT>::Pointer t) {
+  if (!checkReachabilityInput(g, s, t)) {
+    return -1;
+  }
+  return hopDistanceOnGraph(g, s, t);
+}
+
+template <typename DataT>
+bool isReachable(const Graph<DataT> *g, typename Graph<DataT>::Pointer s,
+                 typename Graph<DataT>::Pointer t) {
+  return hopDistance(g, s, t) >= 0;
+}
+
+// Answers many s-t queries against one graph. The graph is snapshotted into
+// a CompactGraph once and the visited marks are epoch-stamped, so a query
+// allocates nothing and resetting the scratch buffers is O(1).
+// Rebuild the object after the source graph changes.
+template <typename DataT> class BatchReachability {
+public:
+  typedef typename Graph<DataT>::Pointer Pointer;
+
+  explicit BatchReachability(const Graph<DataT> *g) : graph_(g) {
+    const size_t n = graph_.numVertexs();
+    fwd_.resize(n);
+    bwd_.resize(n);
+  }
+
+  int hopDistance(Pointer s, Pointer t) {
+    const int sid = graph_.indexOf(s);
+    const int tid = graph_.indexOf(t);
+    if (sid < 0 || tid < 0) {
+      return -1;
+    }
+    nextEpoch();
+    auto forEachOut = [this](int u, const auto &fn) {
+      const auto &targets = graph_.outTargets();
+      for (size_t a = graph_.outBegin(u); a < graph_.outEnd(u); ++a) {
+        fn(targets[a]);
+      }
+    };
+    auto forEachIn = [this](int v, const auto &fn) {
+      const auto &sources = graph_.inSources();
+      for (size_t a = graph_.inBegin(v); a < graph_.inEnd(v); ++a) {
+        fn(sources[a]);
+      }
+    };
+    return bidirectionalHops<int>(sid, tid, fwd_, bwd_, fwd_frontier_,
+                                  bwd_frontier_, next_, forEachOut, forEachIn);
+  }
+
+  bool isReachable(Pointer s, Pointer t) { return hopDistance(s, t) >= 0; }
+
+  std::vector<int>
+  hopDistance(const std::vector<std::pair<Pointer, Pointer>> &queries) {
+    std::vector<int> res;
+    res.reserve(queries.size());
+    for (const auto &q : queries) {
+      res.push_back(hopDistance(q.first, q.second));
+    }
+    return res;
+  }
+
+  std::vector<bool>
+  isReachable(const std::vector<std::pair<Pointer, Pointer>> &queries) {
+    std::vector<bool> res;
+    res.reserve(queries.size());
+    for (const auto &q : queries) {
+      res.push_back(isReachable(q.first, q.second));
+    }
+    return res;
+  }
+
+  const CompactGraph<DataT> &graph() const { return graph_; }
+
+private:
+  // hop count of a vertex is valid only when its stamp equals the epoch
+  struct StampedHops {
+    std::vector<std::uint32_t> stamp;
+    std::vector<int> hops;
+    std::uint32_t epoch = 0;
+    void resize(size_t n) {
+      stamp.assign(n, 0);
+      hops.assign(n, 0);
+    }
+    int get(int v) const { return stamp[v] == epoch ? hops[v] : -1; }
+    void set(int v, int h) {
+      stamp[v] = epoch;
+      hops[v] = h;
+    }
+  };
+
+  void nextEpoch() {
+    if (fwd_.epoch == UINT32_MAX) {
+      fwd_.resize(fwd_.stamp.size());
+      bwd_.resize(bwd_.stamp.size());
+      fwd_.epoch = bwd_.epoch = 0;
+    }
+    ++fwd_.epoch;
+    ++bwd_.epoch;
+  }
+
+  CompactGraph<DataT> graph_;
+  StampedHops fwd_;
+  StampedHops bwd_;
+  std::vector<int> fwd_frontier_;
+  std::vector<int> bwd_frontier_;
+  std::vector<int> next_;
+};
+
+// Reachability index for repeated "does u reach v" queries on a graph that
+// rarely changes. Vertices are collapsed into the SCC condensation, which is
+// a DAG, and every component gets:
+//   - a topological level (u reaches v only if level(u) < level(v)),
+//   - `num_labels` GRAIL intervals [low, post] from randomized post-order
+//     traversals (u reaches v only if every interval of u contains v's),
+//   - the pre/post interval of the first traversal's DFS tree (v inside the
+//     tree interval of u proves reachability).
+// Most queries are decided by these O(num_labels) checks. The remaining ones
+// fall back to a DFS on the condensation that prunes every component whose
+// labels already exclude the target.
+template <typename DataT> class ReachabilityIndex {
+public:
+  typedef typename Graph<DataT>::Pointer Pointer;
+
+  ReachabilityIndex() = default;
+  explicit ReachabilityIndex(const Graph<DataT> *g, int num_labels = 2,
+                             unsigned seed = 5489u) {
+    build(g, num_labels, seed);
+  }
+
+  bool build(const Graph<DataT> *g, int num_labels = 2,
+             unsigned seed = 5489u) {
+    clear();
+    if (g == nullptr) {
+      std::cerr << "input graph is nullptr" << std::endl;
+      return false;
+    }
+    if (!g->isDirected()) {
+      std::cerr << "reachability index is for directed graph" << std::endl;
+      return false;
+    }
+    num_labels_ = std::max(1, num_labels);
+    TraversalWorkspace<DataT> ws(g);
+    auto scc = getSCCLabels(g, Tarjan, ws);
+    const auto &cg = ws.graph();
+    vertexs_ = cg.vertexs();
+    for (size_t i = 0; i < vertexs_.size(); ++i) {
+      index_of_[vertexs_[i]] = static_cast<int>(i);
+    }
+    num_comps_ = scc.count;
+    comp_of_ = std::move(scc.label);
+
+    std::vector<std::pair<int, int>> arcs;
+    for (int u = 0; u < static_cast<int>(cg.numVertexs()); ++u) {
+      for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+        const int cu = comp_of_[u];
+        const int cv = comp_of_[cg.outTargets()[a]];
+        if (cu != cv) {
+          arcs.push_back({cu, cv});
+        }
+      }
+    }
+    std::sort(arcs.begin(), arcs.end());
+    arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+    dag_offsets_.assign(num_comps_ + 1, 0);
+    dag_targets_.resize(arcs.size());
+    for (size_t i = 0; i < arcs.size(); ++i) {
+      ++dag_offsets_[arcs[i].first + 1];
+      dag_targets_[i] = arcs[i].second;
+    }
+    for (int c = 0; c < num_comps_; ++c) {
+      dag_offsets_[c + 1] += dag_offsets_[c];
+    }
+
+    buildLevels();
+    buildLabels(seed);
+    stamp_.assign(num_comps_, 0);
+    return true;
+  }
+
+  bool empty() const { return vertexs_.empty(); }
+  size_t numVertexs() const { return vertexs_.size(); }
+  int numComponents() const { return num_comps_; }
+  int numLabels() const { return num_labels_; }
+  // vertex order used by save(); load() expects the same order
+  const std::vector<Pointer> &vertexs() const { return vertexs_; }
+
+  bool reaches(Pointer u, Pointer v) {
+    auto iu = index_of_.find(u);
+    auto iv = index_of_.find(v);
+    if (iu == index_of_.end() || iv == index_of_.end()) {
+      return false;
+    }
+    return componentReaches(comp_of_[iu->second], comp_of_[iv->second]);
+  }
+
+  // number of queries that needed the DFS fallback since the last build/load
+  size_t fallbackCount() const { return fallback_count_; }
+
+  // Text serialization of the index. Pointers cannot be persisted, so the
+  // vertexs are written by position; load() takes the vertex list in the
+  // order returned by vertexs() at save time.
+  void save(std::ostream &os) const {
+    os << kMagic << ' ' << vertexs_.size() << ' ' << num_comps_ << ' '
+       << num_labels_ << ' ' << dag_targets_.size() << '\n';
+    writeVector(os, comp_of_);
+    writeVector(os, dag_offsets_);
+    writeVector(os, dag_targets_);
+    writeVector(os, level_);
+    writeVector(os, tree_pre_);
+    writeVector(os, tree_post_);
+    writeVector(os, low_);
+    writeVector(os, post_);
+  }
+
+  bool load(std::istream &is, const std::vector<Pointer> &vertexs) {
+    clear();
+    std::string magic;
+    size_t n = 0, num_arcs = 0;
+    if (!(is >> magic >> n >> num_comps_ >> num_labels_ >> num_arcs) ||
+        magic != kMagic || n != vertexs.size() || num_comps_ < 0 ||
+        static_cast<size_t>(num_comps_) > n || num_labels_ < 1 ||
+        num_labels_ > INT_MAX / std::max(1, num_comps_) ||
+        num_arcs > static_cast<size_t>(INT_MAX) ||
+        num_arcs > static_cast<size_t>(num_comps_) * num_comps_) {
+      std::cerr << "invalid reachability index stream" << std::endl;
+      clear();
+      return false;
+    }
+    const size_t comps = num_comps_;
+    const size_t labels = comps * num_labels_;
+    if (!readVector(is, comp_of_, n) ||
+        !readVector(is, dag_offsets_, comps + 1) ||
+        !readVector(is, dag_targets_, num_arcs) ||
+        !readVector(is, level_, comps) || !readVector(is, tree_pre_, comps) ||
+        !readVector(is, tree_post_, comps) || !readVector(is, low_, labels) ||
+        !readVector(is, post_, labels)) {
+      std::cerr << "truncated reachability index stream" << std::endl;
+      clear();
+      return false;
+    }
+    if (!validIndexes(num_arcs)) {
+      std::cerr << "corrupt reachability index stream" << std::endl;
+      clear();
+      return false;
+    }
+    vertexs_ = vertexs;
+    for (size_t i = 0; i < n; ++i) {
+      index_of_[vertexs_[i]] = static_cast<int>(i);
+    }
+    stamp_.assign(num_comps_, 0);
+    return true;
+  }
+
+private:
+  static constexpr const char *kMagic = "graphTest-reachability-v1";
+
+  void clear() {
+    vertexs_.clear();
+    index_of_.clear();
+    comp_of_.clear();
+    dag_offsets_.assign(1, 0);
+    dag_targets_.clear();
+    level_.clear();
+    tree_pre_.clear();
+    tree_post_.clear();
+    low_.clear();
+    post_.clear();
+    stamp_.clear();
+    stack_.clear();
+    epoch_ = 0;
+    num_comps_ = 0;
+    num_labels_ = 1;
+    fallback_count_ = 0;
+  }
+
+  void buildLevels() {
+    std::vector<int> indeg(num_comps_, 0);
+    for (int t : dag_targets_) {
+      ++indeg[t];
+    }
+    level_.assign(num_comps_, 0);
+    std::vector<int> order;
+    order.reserve(num_comps_);
+    for (int c = 0; c < num_comps_; ++c) {
+      if (indeg[c] == 0) {
+        order.push_back(c);
+      }
+    }
+    for (size_t i = 0; i < order.size(); ++i) {
+      const int c = order[i];
+      for (int a = dag_offsets_[c]; a < dag_offsets_[c + 1]; ++a) {
+        const int t = dag_targets_[a];
+        level_[t] = std::max(level_[t], level_[c] + 1);
+        if (--indeg[t] == 0) {
+          order.push_back(t);
+        }
+      }
+    }
+  }
+
+  void buildLabels(unsigned seed) {
+    std::mt19937 rng(seed);
+    low_.assign(static_cast<size_t>(num_comps_) * num_labels_, 0);
+    post_.assign(static_cast<size_t>(num_comps_) * num_labels_, 0);
+    tree_pre_.assign(num_comps_, 0);
+    tree_post_.assign(num_comps_, 0);
+
+    std::vector<int> roots;
+    for (int c = 0; c < num_comps_; ++c) {
+      if (level_[c] == 0) {
+        roots.push_back(c);
+      }
+    }
+    std::vector<char> visited(num_comps_);
+    std::vector<int> rotate(num_comps_);
+    std::vector<std::pair<int, int>> stk;
+    for (int k = 0; k < num_labels_; ++k) {
+      std::fill(visited.begin(), visited.end(), 0);
+      if (k > 0) {
+        std::shuffle(roots.begin(), roots.end(), rng);
+      }
+      for (int c = 0; c < num_comps_; ++c) {
+        const int deg = dag_offsets_[c + 1] - dag_offsets_[c];
+        rotate[c] = (k == 0 || deg == 0) ? 0 : static_cast<int>(rng() % deg);
+      }
+      int pre_rank = 0;
+      int post_rank = 0;
+      for (int root : roots) {
+        if (visited[root]) {
+          continue;
+        }
+        visited[root] = 1;
+        if (k == 0) {
+          tree_pre_[root] = ++pre_rank;
+        }
+        stk.push_back({root, 0});
+        while (!stk.empty()) {
+          const int c = stk.back().first;
+          const int deg = dag_offsets_[c + 1] - dag_offsets_[c];
+          if (stk.back().second < deg) {
+            const int i = stk.back().second++;
+            const int child =
+                dag_targets_[dag_offsets_[c] + (rotate[c] + i) % deg];
+            if (!visited[child]) {
+              visited[child] = 1;
+              if (k == 0) {
+                tree_pre_[child] = ++pre_rank;
+              }
+              stk.push_back({child, 0});
+            }
+            continue;
+          }
+          stk.pop_back();
+          const size_t slot = static_cast<size_t>(c) * num_labels_ + k;
+          post_[slot] = ++post_rank;
+          int low = post_[slot];
+          for (int a = dag_offsets_[c]; a < dag_offsets_[c + 1]; ++a) {
+            low = std::min(
+                low, low_[static_cast<size_t>(dag_targets_[a]) * num_labels_ +
+                          k]);
+          }
+          low_[slot] = low;
+          if (k == 0) {
+            tree_post_[c] = post_rank;
+          }
+        }
+      }
+    }
+  }
+
+  // true when no label rules out cu -> cv
+  bool labelsContain(int cu, int cv) const {
+    const size_t bu = static_cast<size_t>(cu) * num_labels_;
+    const size_t bv = static_cast<size_t>(cv) * num_labels_;
+    for (int k = 0; k < num_labels_; ++k) {
+      if (low_[bv + k] < low_[bu + k] || post_[bv + k] > post_[bu + k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool componentReaches(int cu, int cv) {
+    if (cu == cv) {
+      return true;
+    }
+    if (level_[cu] >= level_[cv] || !labelsContain(cu, cv)) {
+      return false;
+    }
+    if (tree_pre_[cu] <= tree_pre_[cv] && tree_post_[cv] <= tree_post_[cu]) {
+      return true;
+    }
+
+    ++fallback_count_;
+    if (++epoch_ == 0) {
+      std::fill(stamp_.begin(), stamp_.end(), 0);
+      epoch_ = 1;
+    }
+    stack_.clear();
+    stack_.push_back(cu);
+    stamp_[cu] = epoch_;
+    while (!stack_.empty()) {
+      const int c = stack_.back();
+      stack_.pop_back();
+      for (int a = dag_offsets_[c]; a < dag_offsets_[c + 1]; ++a) {
+        const int t = dag_targets_[a];
+        if (t == cv) {
+          return true;
+        }
+        if (stamp_[t] == epoch_ || level_[t] >= level_[cv] ||
+            !labelsContain(t, cv)) {
+          continue;
+        }
+        if (tree_pre_[t] <= tree_pre_[cv] && tree_post_[cv] <= tree_post_[t]) {
+          return true;
+        }
+        stamp_[t] = epoch_;
+        stack_.push_back(t);
+      }
+    }
+    return false;
+  }
+
+  template <typename V>
+  static void writeVector(std::ostream &os, const std::vector<V> &vec) {
+    for (size_t i = 0; i < vec.size(); ++i) {
+      os << vec[i] << (i + 1 == vec.size() ? "" : " ");
+    }
+    os << '\n';
+  }
+
+  // grows with the values actually read, so a bad count in a short stream
+  // fails without allocating for it first
+  template <typename V>
+  static bool readVector(std::istream &is, std::vector<V> &vec, size_t n) {
+    vec.clear();
+    vec.reserve(std::min<size_t>(n, 1 << 16));
+    V value;
+    for (size_t i = 0; i < n; ++i) {
+      if (!(is >> value)) {
+        return false;
+      }
+      vec.push_back(value);
+    }
+    return true;
+  }
+
+  // the loaded arrays index each other; check every index is in range
+  bool validIndexes(size_t num_arcs) const {
+    for (int c : comp_of_) {
+      if (c < 0 || c >= num_comps_) {
+        return false;
+      }
+    }
+    if (dag_offsets_[0] != 0 ||
+        static_cast<size_t>(dag_offsets_[num_comps_]) != num_arcs) {
+      return false;
+    }
+    for (int c = 0; c < num_comps_; ++c) {
+      if (dag_offsets_[c] > dag_offsets_[c + 1]) {
+        return false;
+      }
+    }
+    for (int t : dag_targets_) {
+      if (t < 0 || t >= num_comps_) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<Pointer> vertexs_;
+  std::unordered_map<Pointer, int> index_of_;
+  std::vector<int> comp_of_;
+  std::vector<int> dag_offsets_{0};
+  std::vector<int> dag_targets_;
+  std::vector<int> level_;
+  std::vector<int> tree_pre_;
+  std::vector<int> tree_post_;
+  // GRAIL labels, num_labels_ consecutive entries per component
+  std::vector<int> low_;
+  std::vector<int> post_;
+  std::vector<std::uint32_t> stamp_;
+  std::vector<int> stack_;
+  std::uint32_t epoch_ = 0;
+  int num_comps_ = 0;
+  int num_labels_ = 1;
+  size_t fallback_count_ = 0;
+};
+
+} // namespace graphTest
@@ -1,12 +1,21 @@
 #pragma once
 
+#include "compact_graph.hpp"
 #include "graph.hpp"
+#include "parallel.hpp"
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <climits>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace {
 using graphTest::Graph;
@@ -19,12 +28,9 @@ ShortestPathOneSourceDIJKSTRA(Graph<T> *graph, T *source) {
   if (!graph || !source)
     return {};
 
-  auto all_edges = graph->getAllEdges();
-  for (const auto &edge : all_edges) {
-    if (edge.weight_ < 0) {
-      std::cerr << "DIJKSTRA cannot handle negative weight edges" << std::endl;
-      return {};
-    }
+  if (graph->hasNegativeWeight()) {
+    std::cerr << "DIJKSTRA cannot handle negative weight edges" << std::endl;
+    return {};
   }
 
   std::unordered_map<Pointer, int> dist;
@@ -74,6 +80,381 @@ ShortestPathOneSourceDIJKSTRA(Graph<T> *graph, T *source) {
   return res;
 }
 
+// Parent edges of a shortest path tree from final distances, in vertex
+// order. A vertex takes its first tight in-arc of positive weight; vertexs
+// only reached through zero-weight arcs are then attached by a search along
+// tight zero-weight arcs, which can not close a cycle. With potential the
+// distances are for the reduced weights w + potential[u] - potential[v],
+// which must not be negative; the edges keep their original weights.
+template <typename T>
+std::vector<typename Graph<T>::Edge>
+shortestPathTreeFromDistances(const graphTest::CompactGraph<T> &cg, int s,
+                              const std::vector<std::uint64_t> &dist,
+                              const std::vector<long long> *potential =
+                                  nullptr) {
+  using Edge = typename Graph<T>::Edge;
+  using Vertex = typename Graph<T>::Vertex;
+  const int n = static_cast<int>(cg.numVertexs());
+  const std::uint64_t inf = ~std::uint64_t(0);
+  auto reduced = [&](int u, int v, int w) {
+    long long r = w;
+    if (potential != nullptr) {
+      r += (*potential)[u] - (*potential)[v];
+    }
+    return static_cast<std::uint64_t>(r);
+  };
+  std::vector<int> parent(n, -1);
+  std::vector<int> parent_weight(n, 0);
+  std::vector<int> queue;
+  for (int v = 0; v < n; ++v) {
+    if (v == s || dist[v] == inf) {
+      continue;
+    }
+    for (size_t a = cg.inBegin(v); a < cg.inEnd(v); ++a) {
+      const int u = cg.inSources()[a];
+      const std::uint64_t w = reduced(u, v, cg.inWeights()[a]);
+      if (w > 0 && dist[u] != inf && dist[u] + w == dist[v]) {
+        parent[v] = u;
+        parent_weight[v] = cg.inWeights()[a];
+        queue.push_back(v);
+        break;
+      }
+    }
+  }
+  queue.push_back(s);
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const int u = queue[head];
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      const int v = cg.outTargets()[a];
+      if (reduced(u, v, cg.outWeights()[a]) == 0 && v != s &&
+          parent[v] < 0 && dist[v] == dist[u]) {
+        parent[v] = u;
+        parent_weight[v] = cg.outWeights()[a];
+        queue.push_back(v);
+      }
+    }
+  }
+  std::vector<Edge> res;
+  for (int v = 0; v < n; ++v) {
+    if (parent[v] >= 0) {
+      res.push_back(Edge(Vertex(cg.vertexAt(parent[v])),
+                         Vertex(cg.vertexAt(v)), parent_weight[v]));
+    }
+  }
+  return res;
+}
+
+// Parent edges of a shortest path tree by a search from s along tight arcs,
+// d[u] + w == d[v], in vertex order. Works with negative weights as long as
+// there is no negative cycle; distances at or above unreachable are
+// unreachable.
+template <typename T, typename D>
+std::vector<typename Graph<T>::Edge>
+shortestPathTreeFromTightArcs(const graphTest::CompactGraph<T> &cg, int s,
+                              const D *dist, D unreachable) {
+  using Edge = typename Graph<T>::Edge;
+  using Vertex = typename Graph<T>::Vertex;
+  const int n = static_cast<int>(cg.numVertexs());
+  std::vector<int> parent(n, -1);
+  std::vector<int> parent_weight(n, 0);
+  std::vector<int> queue(1, s);
+  parent[s] = s;
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const int u = queue[head];
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      const int v = cg.outTargets()[a];
+      const int w = cg.outWeights()[a];
+      if (parent[v] < 0 && dist[v] < unreachable &&
+          static_cast<long long>(dist[u]) + w == dist[v]) {
+        parent[v] = u;
+        parent_weight[v] = w;
+        queue.push_back(v);
+      }
+    }
+  }
+  std::vector<Edge> res;
+  for (int v = 0; v < n; ++v) {
+    if (v != s && parent[v] >= 0) {
+      res.push_back(Edge(Vertex(cg.vertexAt(parent[v])),
+                         Vertex(cg.vertexAt(v)), parent_weight[v]));
+    }
+  }
+  return res;
+}
+
+// Monotone priority queue for integer keys (Ahuja, Mehlhorn, Orlin,
+// Tarjan). Bucket i holds the keys whose highest bit differing from the last
+// popped key is bit i - 1, so a key moves to a lower bucket at most 64 times
+// and pop() is amortized O(log C) for a key range C. Keys pushed must not be
+// below the last popped key, which Dijkstra guarantees.
+class RadixHeap {
+public:
+  bool empty() const { return size_ == 0; }
+
+  void push(std::uint64_t key, int value) {
+    buckets_[bucketOf(key)].push_back({key, value});
+    ++size_;
+  }
+
+  std::pair<std::uint64_t, int> pop() {
+    if (buckets_[0].empty()) {
+      size_t i = 1;
+      while (buckets_[i].empty()) {
+        ++i;
+      }
+      last_ = buckets_[i][0].first;
+      for (const auto &item : buckets_[i]) {
+        last_ = std::min(last_, item.first);
+      }
+      for (const auto &item : buckets_[i]) {
+        buckets_[bucketOf(item.first)].push_back(item);
+      }
+      buckets_[i].clear();
+    }
+    auto item = buckets_[0].back();
+    buckets_[0].pop_back();
+    --size_;
+    return item;
+  }
+
+private:
+  size_t bucketOf(std::uint64_t key) const {
+    return static_cast<size_t>(std::bit_width(key ^ last_));
+  }
+
+  std::vector<std::pair<std::uint64_t, int>> buckets_[65];
+  std::uint64_t last_ = 0;
+  size_t size_ = 0;
+};
+
+// Dijkstra on the CSR snapshot with flat distance arrays. With a small
+// largest weight C, Dial's C + 1 circular buckets give O(E + V * C) without
+// any key comparisons; otherwise a radix heap is used. Both keep stale
+// entries and skip them on pop like the binary heap version. The tree is
+// derived from the final distances, so it does not depend on the order in
+// which equal distances were found.
+template <typename T>
+std::vector<typename Graph<T>::Edge>
+ShortestPathOneSourceDIJKSTRA_RADIX(Graph<T> *graph, T *source) {
+  if (!graph || !source)
+    return {};
+  if (graph->hasNegativeWeight()) {
+    std::cerr << "DIJKSTRA cannot handle negative weight edges" << std::endl;
+    return {};
+  }
+  graphTest::CompactGraph<T> cg(graph);
+  const int s = cg.indexOf(source);
+  if (s < 0)
+    return {};
+
+  const int n = static_cast<int>(cg.numVertexs());
+  const auto &targets = cg.outTargets();
+  const auto &weights = cg.outWeights();
+  const std::uint64_t inf = ~std::uint64_t(0);
+  std::vector<std::uint64_t> dist(n, inf);
+  dist[s] = 0;
+  auto relax = [&](int u, auto &&push) {
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      const int v = targets[a];
+      const std::uint64_t d =
+          dist[u] + static_cast<std::uint64_t>(weights[a]);
+      if (d < dist[v]) {
+        dist[v] = d;
+        push(d, v);
+      }
+    }
+  };
+
+  int max_weight = 0;
+  for (int w : weights) {
+    max_weight = std::max(max_weight, w);
+  }
+  const int dial_max_weight = 1 << 12;
+  if (max_weight <= dial_max_weight) {
+    const size_t num_buckets = static_cast<size_t>(max_weight) + 1;
+    std::vector<std::vector<int>> buckets(num_buckets);
+    size_t pending = 1;
+    buckets[0].push_back(s);
+    auto push = [&](std::uint64_t d, int v) {
+      buckets[d % num_buckets].push_back(v);
+      ++pending;
+    };
+    for (std::uint64_t cur = 0; pending > 0; ++cur) {
+      auto &bucket = buckets[cur % num_buckets];
+      // relaxing with a zero weight appends to the bucket being scanned
+      for (size_t i = 0; i < bucket.size(); ++i) {
+        const int u = bucket[i];
+        --pending;
+        if (dist[u] == cur) {
+          relax(u, push);
+        }
+      }
+      bucket.clear();
+    }
+  } else {
+    RadixHeap heap;
+    heap.push(0, s);
+    auto push = [&](std::uint64_t d, int v) { heap.push(d, v); };
+    while (!heap.empty()) {
+      const auto top = heap.pop();
+      if (top.first == dist[top.second]) {
+        relax(top.second, push);
+      }
+    }
+  }
+
+  return shortestPathTreeFromDistances(cg, s, dist);
+}
+
+inline bool atomicMinDistance(std::atomic<std::uint64_t> &slot,
+                              std::uint64_t d) {
+  std::uint64_t cur = slot.load(std::memory_order_relaxed);
+  while (d < cur) {
+    if (slot.compare_exchange_weak(cur, d, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Delta-stepping (Meyer, Sanders). Tentative distances are grouped into
+// buckets of width delta. The vertexs of the lowest non-empty bucket are
+// relaxed together: light arcs (weight <= delta) repeatedly until the
+// bucket stays empty, since they can refill it, then heavy arcs once for
+// every vertex the bucket settled. Each relaxation phase runs over blocks
+// of the frontier on num_threads threads with an atomic min on the
+// distance; improved vertexs are collected in per-thread buffers and moved
+// into buckets between phases. The threads are started once per call and
+// small phases, common on high-diameter graphs, run on the calling thread. delta 0 picks the largest weight divided by
+// the average out-degree. Buckets live in a circular array covering one
+// largest weight ahead of the current bucket. The tree is derived from the
+// distances like in DIJKSTRA_RADIX, so both return the same parent edges.
+template <typename T>
+std::vector<typename Graph<T>::Edge>
+ShortestPathOneSourceDELTA_STEPPING(Graph<T> *graph, T *source,
+                                    size_t num_threads = 0,
+                                    std::uint64_t delta = 0) {
+  if (!graph || !source)
+    return {};
+  if (graph->hasNegativeWeight()) {
+    std::cerr << "DELTA_STEPPING cannot handle negative weight edges"
+              << std::endl;
+    return {};
+  }
+  graphTest::CompactGraph<T> cg(graph);
+  const int s = cg.indexOf(source);
+  if (s < 0)
+    return {};
+  if (num_threads == 0) {
+    num_threads = graphTest::defaultThreadCount();
+  }
+
+  const int n = static_cast<int>(cg.numVertexs());
+  const auto &targets = cg.outTargets();
+  const auto &weights = cg.outWeights();
+  std::uint64_t max_weight = 0;
+  for (int w : weights) {
+    max_weight = std::max<std::uint64_t>(max_weight, w);
+  }
+  if (delta == 0) {
+    const std::uint64_t avg_degree =
+        std::max<std::uint64_t>(1, cg.numArcs() / std::max(1, n));
+    delta = std::max<std::uint64_t>(1, max_weight / avg_degree);
+  }
+  const std::uint64_t inf = ~std::uint64_t(0);
+  std::vector<std::atomic<std::uint64_t>> dist(n);
+  for (auto &d : dist) {
+    d.store(inf, std::memory_order_relaxed);
+  }
+  dist[s].store(0, std::memory_order_relaxed);
+
+  const size_t num_buckets = static_cast<size_t>(max_weight / delta) + 2;
+  std::vector<std::vector<int>> buckets(num_buckets);
+  size_t pending = 1;
+  buckets[0].push_back(s);
+  std::vector<std::vector<int>> improved(num_threads);
+  // mark[v] == stamp: v is already in the current frontier
+  std::vector<std::uint64_t> mark(n, 0);
+  std::vector<std::uint64_t> settled_mark(n, 0);
+  std::uint64_t stamp = 0;
+  std::vector<int> frontier;
+  std::vector<int> settled;
+
+  // a phase whose vertexs have fewer out-arcs than this is relaxed on the
+  // calling thread; waking the workers would cost more than the relaxations
+  const size_t parallel_arcs = 4096;
+  graphTest::ThreadTeam team(num_threads);
+
+  // relaxes the light or heavy arcs of every vertex in vs
+  auto relaxAll = [&](const std::vector<int> &vs, bool light) {
+    auto relaxBlock = [&](size_t t, size_t begin, size_t end) {
+      auto &out = improved[t];
+      for (size_t i = begin; i < end; ++i) {
+        const int u = vs[i];
+        const std::uint64_t du = dist[u].load(std::memory_order_relaxed);
+        for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+          const std::uint64_t w = static_cast<std::uint64_t>(weights[a]);
+          if ((w <= delta) == light &&
+              atomicMinDistance(dist[targets[a]], du + w)) {
+            out.push_back(targets[a]);
+          }
+        }
+      }
+    };
+    size_t arcs = 0;
+    for (size_t i = 0; i < vs.size() && arcs < parallel_arcs; ++i) {
+      arcs += cg.outEnd(vs[i]) - cg.outBegin(vs[i]);
+    }
+    if (arcs < parallel_arcs) {
+      relaxBlock(0, 0, vs.size());
+    } else {
+      team.forBlocks(vs.size(), relaxBlock);
+    }
+    for (auto &out : improved) {
+      for (int v : out) {
+        const std::uint64_t d = dist[v].load(std::memory_order_relaxed);
+        buckets[(d / delta) % num_buckets].push_back(v);
+        ++pending;
+      }
+      out.clear();
+    }
+  };
+
+  for (std::uint64_t cur = 0; pending > 0; ++cur) {
+    auto &bucket = buckets[cur % num_buckets];
+    if (bucket.empty()) {
+      continue;
+    }
+    const std::uint64_t settle_stamp = cur + 1;
+    settled.clear();
+    while (!bucket.empty()) {
+      ++stamp;
+      frontier.clear();
+      for (int v : bucket) {
+        --pending;
+        if (dist[v].load(std::memory_order_relaxed) / delta == cur &&
+            mark[v] != stamp) {
+          mark[v] = stamp;
+          frontier.push_back(v);
+          if (settled_mark[v] != settle_stamp) {
+            settled_mark[v] = settle_stamp;
+            settled.push_back(v);
+          }
+        }
+      }
+      bucket.clear();
+      relaxAll(frontier, true);
+    }
+    relaxAll(settled, false);
+  }
+
+  std::vector<std::uint64_t> final_dist(n);
+  for (int v = 0; v < n; ++v) {
+    final_dist[v] = dist[v].load(std::memory_order_relaxed);
+  }
+  return shortestPathTreeFromDistances(cg, s, final_dist);
+}
+
 template <typename T>
 std::vector<typename Graph<T>::Edge>
 ShortestPathOneSourceBELLMAN_FORD(Graph<T> *graph, T *source) {
@@ -95,7 +476,9 @@ ShortestPathOneSourceBELLMAN_FORD(Graph<T> *graph, T *source) {
   size_t V = vertices.size();
   auto edges = graph->getAllEdges();
 
+  // a pass that changes nothing means every later pass would not either
   for (size_t i = 1; i < V; ++i) {
+    bool changed = false;
     for (const auto &edge : edges) {
       Pointer u = edge.from.get_data();
       Pointer v = edge.to.get_data();
@@ -104,8 +487,12 @@ ShortestPathOneSourceBELLMAN_FORD(Graph<T> *graph, T *source) {
         dist[v] = dist[u] + weight;
         parent[v] = u;
         parent_edge.insert_or_assign(v, edge);
+        changed = true;
       }
     }
+    if (!changed) {
+      break;
+    }
   }
 
   for (const auto &edge : edges) {
@@ -127,88 +514,479 @@ ShortestPathOneSourceBELLMAN_FORD(Graph<T> *graph, T *source) {
   return res;
 }
 
+// Bellman-Ford over the arcs as three flat arrays src[], dst[] and w[]
+// (struct of arrays) with distances in a dense array. Every pass splits
+// the arcs in contiguous blocks over num_threads threads and lowers
+// distances with an atomic min. A thread may already see distances
+// lowered in the same pass, which only speeds things up: after pass i
+// every path of i arcs is still accounted for. Stops after a pass without
+// change; a change in pass n means a negative cycle.
 template <typename T>
-std::unordered_map<typename Graph<T>::Pointer,
-                   std::vector<typename Graph<T>::Edge>>
-ShortestPathAllPairsFLOYD_WARSHALL(Graph<T> *graph) {
-  using Pointer = typename Graph<T>::Pointer;
-  using Edge = typename Graph<T>::Edge;
-  if (!graph)
+std::vector<typename Graph<T>::Edge>
+ShortestPathOneSourceBELLMAN_FORD_PARALLEL(Graph<T> *graph, T *source,
+                                           size_t num_threads = 0) {
+  if (!graph || !source)
+    return {};
+  graphTest::CompactGraph<T> cg(graph);
+  const int s = cg.indexOf(source);
+  if (s < 0)
     return {};
+  if (num_threads == 0) {
+    num_threads = graphTest::defaultThreadCount();
+  }
+  const int n = static_cast<int>(cg.numVertexs());
+  const size_t m = cg.numArcs();
+  std::vector<int> src(m);
+  for (int u = 0; u < n; ++u) {
+    std::fill(src.begin() + cg.outBegin(u), src.begin() + cg.outEnd(u), u);
+  }
+  const int *dst = cg.outTargets().data();
+  const int *w = cg.outWeights().data();
 
-  auto vertices = graph->getAllVertexs();
-  std::unordered_map<Pointer, std::unordered_map<Pointer, int>> dist;
-  std::unordered_map<Pointer, std::unordered_map<Pointer, Pointer>> next;
-  std::unordered_map<Pointer, std::unordered_map<Pointer, Edge>> edge_map;
+  const long long inf = LLONG_MAX;
+  std::vector<std::atomic<long long>> dist(n);
+  for (auto &d : dist) {
+    d.store(inf, std::memory_order_relaxed);
+  }
+  dist[s].store(0, std::memory_order_relaxed);
+  std::vector<char> changed(num_threads);
+  bool converged = false;
+  for (int pass = 0; pass < n && !converged; ++pass) {
+    std::fill(changed.begin(), changed.end(), 0);
+    graphTest::parallelForBlocks(
+        m, num_threads, [&](size_t t, size_t begin, size_t end) {
+          bool local = false;
+          for (size_t e = begin; e < end; ++e) {
+            const long long du = dist[src[e]].load(std::memory_order_relaxed);
+            if (du == inf) {
+              continue;
+            }
+            const long long d = du + w[e];
+            auto &slot = dist[dst[e]];
+            long long cur = slot.load(std::memory_order_relaxed);
+            while (d < cur) {
+              if (slot.compare_exchange_weak(cur, d,
+                                             std::memory_order_relaxed)) {
+                local = true;
+                break;
+              }
+            }
+          }
+          changed[t] = local;
+        });
+    converged = std::find(changed.begin(), changed.end(), 1) == changed.end();
+  }
+  if (!converged) {
+    std::cerr << "Graph contains a negative-weight cycle" << std::endl;
+    return {};
+  }
+  std::vector<long long> final_dist(n);
+  for (int v = 0; v < n; ++v) {
+    final_dist[v] = dist[v].load(std::memory_order_relaxed);
+  }
+  return shortestPathTreeFromTightArcs(cg, s, final_dist.data(), inf);
+}
 
-  for (auto u : vertices) {
-    for (auto v : vertices) {
-      if (u == v)
-        dist[u][v] = 0;
-      else
-        dist[u][v] = INT_MAX;
+// Queue-based Bellman-Ford (SPFA) with Tarjan's subtree disassembly on the
+// CSR snapshot. The current shortest path tree is kept as a preorder list
+// with depths. When a vertex v improves, its whole subtree is cut off,
+// since those distances are stale; the cut vertexs stay in the queue but
+// are skipped until they improve again. If the vertex u whose arc improved
+// v is in that subtree, the arc closes a negative cycle, which is found as
+// soon as it exists in the parent graph instead of after n passes. s < 0
+// starts from a virtual source with a zero-weight arc to every vertex.
+// Returns false on a negative cycle and fills cycle with its edges in
+// order, otherwise fills tree with the parent edges in vertex order.
+template <typename T>
+bool shortestPathSPFA(const graphTest::CompactGraph<T> &cg, int s,
+                      std::vector<typename Graph<T>::Edge> &tree,
+                      std::vector<typename Graph<T>::Edge> &cycle) {
+  using Edge = typename Graph<T>::Edge;
+  using Vertex = typename Graph<T>::Vertex;
+  const int n = static_cast<int>(cg.numVertexs());
+  const int root = s >= 0 ? s : n;
+  std::vector<long long> dist(n + 1, LLONG_MAX);
+  std::vector<int> parent(n + 1, -1);
+  std::vector<int> parent_weight(n + 1, 0);
+  std::vector<int> depth(n + 1, 0);
+  // preorder list of the tree, circular through root
+  std::vector<int> prev(n + 1);
+  std::vector<int> next(n + 1);
+  std::vector<char> attached(n + 1, 0);
+  std::vector<char> in_queue(n + 1, 0);
+  std::queue<int> queue;
+  auto attach = [&](int u, int v, int w) {
+    parent[v] = u;
+    parent_weight[v] = w;
+    depth[v] = depth[u] + 1;
+    attached[v] = 1;
+    next[v] = next[u];
+    prev[next[u]] = v;
+    next[u] = v;
+    prev[v] = u;
+    if (!in_queue[v]) {
+      in_queue[v] = 1;
+      queue.push(v);
     }
+  };
+  dist[root] = 0;
+  attached[root] = 1;
+  prev[root] = next[root] = root;
+  if (root == n) {
+    for (int v = 0; v < n; ++v) {
+      dist[v] = 0;
+      attach(root, v, 0);
+    }
+  } else {
+    in_queue[root] = 1;
+    queue.push(root);
   }
 
-  auto edges = graph->getAllEdges();
-  for (const auto &edge : edges) {
-    Pointer u = edge.from.get_data();
-    Pointer v = edge.to.get_data();
-    dist[u][v] = edge.weight_;
-    next[u][v] = v;
-    edge_map[u].insert_or_assign(v, edge);
-  }
-
-  for (auto k : vertices) {
-    for (auto i : vertices) {
-      for (auto j : vertices) {
-        if (dist[i][k] != INT_MAX && dist[k][j] != INT_MAX) {
-          if (dist[i][k] + dist[k][j] < dist[i][j]) {
-            dist[i][j] = dist[i][k] + dist[k][j];
-            next[i][j] = next[i][k];
+  tree.clear();
+  cycle.clear();
+  while (!queue.empty()) {
+    const int u = queue.front();
+    queue.pop();
+    in_queue[u] = 0;
+    if (!attached[u]) {
+      continue;
+    }
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      const int v = cg.outTargets()[a];
+      const int w = cg.outWeights()[a];
+      const long long d = dist[u] + w;
+      if (d >= dist[v]) {
+        continue;
+      }
+      if (attached[v]) {
+        bool closes_cycle = u == v;
+        int x = next[v];
+        while (!closes_cycle && x != root && depth[x] > depth[v]) {
+          closes_cycle = x == u;
+          attached[x] = 0;
+          x = next[x];
+        }
+        if (closes_cycle) {
+          // tree path v .. u, then the arc back to v
+          for (int y = u; y != v; y = parent[y]) {
+            cycle.push_back(Edge(Vertex(cg.vertexAt(parent[y])),
+                                 Vertex(cg.vertexAt(y)), parent_weight[y]));
           }
+          std::reverse(cycle.begin(), cycle.end());
+          cycle.push_back(Edge(Vertex(cg.vertexAt(u)), Vertex(cg.vertexAt(v)),
+                               w));
+          return false;
         }
+        next[prev[v]] = x;
+        prev[x] = prev[v];
+        attached[v] = 0;
       }
+      dist[v] = d;
+      attach(u, v, w);
     }
   }
+  for (int v = 0; v < n; ++v) {
+    if (v != root && attached[v] && parent[v] != n) {
+      tree.push_back(Edge(Vertex(cg.vertexAt(parent[v])),
+                          Vertex(cg.vertexAt(v)), parent_weight[v]));
+    }
+  }
+  return true;
+}
 
-  for (auto v : vertices) {
-    if (dist[v][v] < 0) {
-      std::cerr << "Graph contains a negative-weight cycle" << std::endl;
-      return {};
+template <typename T>
+std::vector<typename Graph<T>::Edge>
+ShortestPathOneSourceSPFA(Graph<T> *graph, T *source) {
+  if (!graph || !source)
+    return {};
+  graphTest::CompactGraph<T> cg(graph);
+  const int s = cg.indexOf(source);
+  if (s < 0)
+    return {};
+  std::vector<typename Graph<T>::Edge> tree;
+  std::vector<typename Graph<T>::Edge> cycle;
+  if (!shortestPathSPFA(cg, s, tree, cycle)) {
+    std::cerr << "Graph contains a negative-weight cycle" << std::endl;
+    return {};
+  }
+  return tree;
+}
+
+// side of a Floyd-Warshall tile; a tile of ints fits in L1, and the fixed
+// trip count lets the compiler vectorize the row loop without an epilogue
+constexpr int kFloydTile = 64;
+
+// c = min(c, a + b) in min-plus algebra over [k_begin, k_end) of one tile,
+// k outermost so c may alias a or b. Entries of a at or above unreachable
+// are skipped; the j loop is branch-free. Row k of b is copied to a local
+// array first, which keeps the j loop free of possible aliasing so it is
+// vectorized without runtime alias checks.
+template <typename D>
+void floydMinPlusTile(D *c, const D *a, const D *b, size_t stride,
+                      D unreachable, int k_begin = 0,
+                      int k_end = kFloydTile) {
+  D bk[kFloydTile];
+  for (int k = k_begin; k < k_end; ++k) {
+    std::copy(b + k * stride, b + k * stride + kFloydTile, bk);
+    for (int i = 0; i < kFloydTile; ++i) {
+      const D aik = a[i * stride + k];
+      if (aik >= unreachable) {
+        continue;
+      }
+      D *ci = c + i * stride;
+      for (int j = 0; j < kFloydTile; ++j) {
+        const D d = aik + bk[j];
+        ci[j] = d < ci[j] ? d : ci[j];
+      }
+    }
+  }
+}
+
+// Blocked Floyd-Warshall (Venkataraman, Sahni, Mukhopadhyaya) on a
+// row-major matrix padded to whole tiles. For every diagonal tile kb: close
+// the tile itself, then update the tiles of row kb and column kb from it,
+// then every other tile from its row and column tile. The tiles of the
+// last two phases are independent and run on num_threads threads. Returns
+// false as soon as a diagonal entry goes negative, which is checked after
+// every k of the diagonal tile so a negative cycle can not blow up the
+// values.
+template <typename D>
+bool floydWarshallBlocked(std::vector<D> &dist, size_t stride,
+                          size_t num_threads, D unreachable) {
+  const size_t nb = stride / kFloydTile;
+  auto tile = [&](size_t bi, size_t bj) {
+    return dist.data() + (bi * stride + bj) * kFloydTile;
+  };
+  for (size_t kb = 0; kb < nb; ++kb) {
+    D *diag = tile(kb, kb);
+    for (int k = 0; k < kFloydTile; ++k) {
+      floydMinPlusTile(diag, diag, diag, stride, unreachable, k, k + 1);
+      for (int i = 0; i < kFloydTile; ++i) {
+        if (diag[i * stride + i] < 0) {
+          return false;
+        }
+      }
+    }
+    graphTest::parallelForBlocks(
+        2 * nb, num_threads, [&](size_t, size_t begin, size_t end) {
+          for (size_t t = begin; t < end; ++t) {
+            const size_t b = t / 2;
+            if (b == kb) {
+              continue;
+            }
+            if (t % 2 == 0) {
+              floydMinPlusTile(tile(kb, b), diag, tile(kb, b), stride,
+                               unreachable);
+            } else {
+              floydMinPlusTile(tile(b, kb), tile(b, kb), diag, stride,
+                               unreachable);
+            }
+          }
+        });
+    graphTest::parallelForBlocks(
+        nb * nb, num_threads, [&](size_t, size_t begin, size_t end) {
+          for (size_t t = begin; t < end; ++t) {
+            const size_t bi = t / nb;
+            const size_t bj = t % nb;
+            if (bi != kb && bj != kb) {
+              floydMinPlusTile(tile(bi, bj), tile(bi, kb), tile(kb, bj),
+                               stride, unreachable);
+            }
+          }
+        });
+  }
+  return true;
+}
+
+// Runs the blocked kernel with distance type D, then derives every tree by
+// a search along tight arcs from its source.
+template <typename D, typename T>
+std::unordered_map<typename Graph<T>::Pointer,
+                   std::vector<typename Graph<T>::Edge>>
+floydWarshallDense(const graphTest::CompactGraph<T> &cg,
+                   size_t num_threads) {
+  using Pointer = typename Graph<T>::Pointer;
+  using Edge = typename Graph<T>::Edge;
+  const size_t n = cg.numVertexs();
+  const size_t stride = (n + kFloydTile - 1) / kFloydTile * kFloydTile;
+  // half the range, so inf + inf and inf plus any path length stay in range
+  const D inf = std::numeric_limits<D>::max() / 2;
+  const D unreachable = inf / 2;
+  std::vector<D> dist(stride * stride, inf);
+  for (size_t v = 0; v < stride; ++v) {
+    dist[v * stride + v] = 0;
+  }
+  for (size_t u = 0; u < n; ++u) {
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      D &d = dist[u * stride + cg.outTargets()[a]];
+      d = std::min<D>(d, cg.outWeights()[a]);
     }
   }
+  if (!floydWarshallBlocked(dist, stride, num_threads, unreachable)) {
+    std::cerr << "Graph contains a negative-weight cycle" << std::endl;
+    return {};
+  }
 
+  std::vector<std::vector<Edge>> trees(n);
+  graphTest::parallelForBlocks(
+      n, num_threads, [&](size_t, size_t begin, size_t end) {
+        for (size_t s = begin; s < end; ++s) {
+          trees[s] = shortestPathTreeFromTightArcs(
+              cg, static_cast<int>(s), dist.data() + s * stride,
+              unreachable);
+        }
+      });
   std::unordered_map<Pointer, std::vector<Edge>> res;
-  for (auto u : vertices) {
-    std::unordered_map<Pointer, Edge> parent_edge;
-    for (auto v : vertices) {
-      if (u != v && dist[u][v] != INT_MAX) {
-        Pointer curr = u;
-        while (curr != v) {
-          Pointer nxt = next[curr][v];
-          if (!nxt)
-            break;
-          parent_edge.insert_or_assign(nxt, edge_map.at(curr).at(nxt));
-          curr = nxt;
+  for (size_t s = 0; s < n; ++s) {
+    res[cg.vertexAt(static_cast<int>(s))] = std::move(trees[s]);
+  }
+  return res;
+}
+
+// Floyd-Warshall on a dense matrix indexed by the CSR vertex ids. Distances
+// are ints when n times the largest absolute weight leaves room for the
+// unreachable marker, which lets the min-plus kernel use 32-bit vector
+// lanes; otherwise long long.
+template <typename T>
+std::unordered_map<typename Graph<T>::Pointer,
+                   std::vector<typename Graph<T>::Edge>>
+ShortestPathAllPairsFLOYD_WARSHALL(Graph<T> *graph, size_t num_threads = 0) {
+  if (!graph)
+    return {};
+  graphTest::CompactGraph<T> cg(graph);
+  long long max_abs = 0;
+  for (int w : cg.outWeights()) {
+    max_abs = std::max(max_abs, std::abs(static_cast<long long>(w)));
+  }
+  const long long bound =
+      static_cast<long long>(cg.numVertexs() + 1) * max_abs;
+  if (bound <= std::numeric_limits<int>::max() / 8) {
+    return floydWarshallDense<int>(cg, num_threads);
+  }
+  return floydWarshallDense<long long>(cg, num_threads);
+}
+
+// Johnson potentials: Bellman-Ford from a virtual source with a zero-weight
+// arc to every vertex, so every potential starts at 0 and only decreases.
+// Passes stop as soon as one changes nothing. Returns false if a pass
+// still changes something after n passes, i.e. on a negative cycle.
+template <typename T>
+bool johnsonPotentials(const graphTest::CompactGraph<T> &cg,
+                       std::vector<long long> &potential) {
+  const int n = static_cast<int>(cg.numVertexs());
+  const auto &targets = cg.outTargets();
+  const auto &weights = cg.outWeights();
+  potential.assign(n, 0);
+  if (!cg.hasNegativeWeight()) {
+    return true;
+  }
+  for (int pass = 0; pass <= n; ++pass) {
+    bool changed = false;
+    for (int u = 0; u < n; ++u) {
+      for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+        const long long d = potential[u] + weights[a];
+        if (d < potential[targets[a]]) {
+          potential[targets[a]] = d;
+          changed = true;
         }
       }
     }
-    std::vector<Edge> spt;
-    for (auto p : parent_edge) {
-      spt.push_back(p.second);
+    if (!changed) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// w + potential[u] - potential[v] for every out-arc, never negative
+template <typename T>
+std::vector<std::uint64_t>
+johnsonReducedWeights(const graphTest::CompactGraph<T> &cg,
+                      const std::vector<long long> &potential) {
+  std::vector<std::uint64_t> reduced(cg.numArcs());
+  for (int u = 0; u < static_cast<int>(cg.numVertexs()); ++u) {
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      reduced[a] = static_cast<std::uint64_t>(
+          cg.outWeights()[a] + potential[u] - potential[cg.outTargets()[a]]);
+    }
+  }
+  return reduced;
+}
+
+// Dijkstra on the reduced weights from s, tree edges with original weights
+template <typename T>
+std::vector<typename Graph<T>::Edge>
+johnsonOneSource(const graphTest::CompactGraph<T> &cg,
+                 const std::vector<long long> &potential,
+                 const std::vector<std::uint64_t> &reduced, int s,
+                 std::vector<std::uint64_t> &dist) {
+  const std::uint64_t inf = ~std::uint64_t(0);
+  dist.assign(cg.numVertexs(), inf);
+  dist[s] = 0;
+  RadixHeap heap;
+  heap.push(0, s);
+  while (!heap.empty()) {
+    const auto top = heap.pop();
+    const int u = top.second;
+    if (top.first != dist[u]) {
+      continue;
+    }
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      const int v = cg.outTargets()[a];
+      const std::uint64_t d = dist[u] + reduced[a];
+      if (d < dist[v]) {
+        dist[v] = d;
+        heap.push(d, v);
+      }
     }
-    res[u] = spt;
   }
+  return shortestPathTreeFromDistances(cg, s, dist, &potential);
+}
 
+// one Dijkstra per source, sources split in blocks over num_threads threads
+template <typename T>
+std::unordered_map<typename Graph<T>::Pointer,
+                   std::vector<typename Graph<T>::Edge>>
+johnsonAllPairs(const graphTest::CompactGraph<T> &cg,
+                const std::vector<long long> &potential,
+                const std::vector<std::uint64_t> &reduced,
+                size_t num_threads) {
+  using Pointer = typename Graph<T>::Pointer;
+  using Edge = typename Graph<T>::Edge;
+  const size_t n = cg.numVertexs();
+  std::vector<std::vector<Edge>> trees(n);
+  graphTest::parallelForBlocks(
+      n, num_threads, [&](size_t, size_t begin, size_t end) {
+        std::vector<std::uint64_t> dist;
+        for (size_t s = begin; s < end; ++s) {
+          trees[s] = johnsonOneSource(cg, potential, reduced,
+                                      static_cast<int>(s), dist);
+        }
+      });
+  std::unordered_map<Pointer, std::vector<Edge>> res;
+  for (size_t s = 0; s < n; ++s) {
+    res[cg.vertexAt(static_cast<int>(s))] = std::move(trees[s]);
+  }
   return res;
 }
 
+// Johnson: potentials from one Bellman-Ford make every weight non-negative,
+// then Dijkstra runs from every source. O(V E log C) instead of the O(V^3)
+// of Floyd-Warshall on sparse graphs.
 template <typename T>
 std::unordered_map<typename Graph<T>::Pointer,
                    std::vector<typename Graph<T>::Edge>>
-ShortestPathAllPairsJOHNSON(Graph<T> *graph) {
-  return ShortestPathAllPairsFLOYD_WARSHALL(graph);
+ShortestPathAllPairsJOHNSON(Graph<T> *graph, size_t num_threads = 0) {
+  if (!graph)
+    return {};
+  graphTest::CompactGraph<T> cg(graph);
+  std::vector<long long> potential;
+  if (!johnsonPotentials(cg, potential)) {
+    std::cerr << "Graph contains a negative-weight cycle" << std::endl;
+    return {};
+  }
+  return johnsonAllPairs(cg, potential, johnsonReducedWeights(cg, potential),
+                         num_threads);
 }
 
 template <typename T>
@@ -218,10 +996,122 @@ ShortestPathOneSourceFLOYD_WARSHALL(Graph<T> *graph, T *source) {
   return ShortestPathAllPairsFLOYD_WARSHALL(graph)[source];
 }
 
+// a single Dijkstra after the potentials; JohnsonShortestPaths keeps the
+// potentials for repeated queries
 template <typename T>
 std::vector<typename Graph<T>::Edge>
 ShortestPathOneSourceJOHNSON(Graph<T> *graph, T *source) {
-  return ShortestPathAllPairsJOHNSON(graph)[source];
+  if (!graph || !source)
+    return {};
+  graphTest::CompactGraph<T> cg(graph);
+  const int s = cg.indexOf(source);
+  if (s < 0)
+    return {};
+  std::vector<long long> potential;
+  if (!johnsonPotentials(cg, potential)) {
+    std::cerr << "Graph contains a negative-weight cycle" << std::endl;
+    return {};
+  }
+  std::vector<std::uint64_t> dist;
+  return johnsonOneSource(cg, potential, johnsonReducedWeights(cg, potential),
+                          s, dist);
+}
+
+// Bidirectional Dijkstra: a forward search over out-edges from s and a
+// backward search over in-edges from t, each with its own heap, always
+// advancing the side whose next key is smaller. Every arc relaxed towards a
+// vertex the other side has labeled is a candidate meeting arc for the
+// best path cost mu. Once the two smallest keys add up to at least mu no
+// shorter path can exist, so only the vertexs around s and t closer than
+// about half the s-t distance are settled. Works on the pointer graph
+// directly so a query never touches the rest of the graph.
+template <typename T>
+bool bidirectionalDijkstra(const Graph<T> *graph, T *s, T *t,
+                           std::vector<typename Graph<T>::Edge> &path,
+                           long long &cost, size_t &settled) {
+  using Pointer = typename Graph<T>::Pointer;
+  using Edge = typename Graph<T>::Edge;
+  using Item = std::pair<long long, Pointer>;
+  using Heap =
+      std::priority_queue<Item, std::vector<Item>, std::greater<Item>>;
+  struct Side {
+    Heap heap;
+    std::unordered_map<Pointer, long long> dist;
+    // forward: edge into the vertex, backward: edge out of it
+    std::unordered_map<Pointer, Edge> parent;
+  };
+  Side fwd, bwd;
+  fwd.dist[s] = 0;
+  bwd.dist[t] = 0;
+  fwd.heap.push({0, s});
+  bwd.heap.push({0, t});
+  const long long inf = LLONG_MAX;
+  long long mu = inf;
+  Edge meet(nullptr, nullptr, 0);
+  std::vector<Edge> edges;
+  settled = 0;
+
+  // drops stale entries, returns the next key of a side
+  auto topKey = [](Side &side) {
+    while (!side.heap.empty() &&
+           side.heap.top().first != side.dist.at(side.heap.top().second)) {
+      side.heap.pop();
+    }
+    return side.heap.empty() ? inf : side.heap.top().first;
+  };
+  while (true) {
+    const long long kf = topKey(fwd);
+    const long long kb = topKey(bwd);
+    if (kf == inf || kb == inf || (mu != inf && kf + kb >= mu)) {
+      break;
+    }
+    const bool forward = kf <= kb;
+    Side &mine = forward ? fwd : bwd;
+    Side &other = forward ? bwd : fwd;
+    const Pointer u = mine.heap.top().second;
+    const long long du = mine.heap.top().first;
+    mine.heap.pop();
+    ++settled;
+    if (forward) {
+      graph->getOutEdges(u, edges);
+    } else {
+      graph->getInEdges(u, edges);
+    }
+    for (const auto &e : edges) {
+      const Pointer v = forward ? e.to.get_data() : e.from.get_data();
+      const long long dv = du + e.weight_;
+      auto it = mine.dist.find(v);
+      if (it == mine.dist.end() || dv < it->second) {
+        mine.dist[v] = dv;
+        mine.parent.insert_or_assign(v, e);
+        mine.heap.push({dv, v});
+      }
+      auto ot = other.dist.find(v);
+      if (ot != other.dist.end() && dv + ot->second < mu) {
+        mu = dv + ot->second;
+        meet = e;
+      }
+    }
+  }
+  if (mu == inf) {
+    return false;
+  }
+  // forward half back to s, then the meeting edge, then on to t
+  path.clear();
+  for (Pointer x = meet.from.get_data(); x != s;) {
+    const Edge &e = fwd.parent.at(x);
+    path.push_back(e);
+    x = e.from.get_data();
+  }
+  std::reverse(path.begin(), path.end());
+  path.push_back(meet);
+  for (Pointer x = meet.to.get_data(); x != t;) {
+    const Edge &e = bwd.parent.at(x);
+    path.push_back(e);
+    x = e.to.get_data();
+  }
+  cost = mu;
+  return true;
 }
 
 template <typename T>
@@ -274,11 +1164,28 @@ KshortestPathUnDirectedA_Star(Graph<T> *graph,
 } // namespace
 namespace graphTest {
 
-enum ShortestPathAlgo { DIJKSTRA, BELLMAN_FORD, FLOYD_WARSHALL, JOHNSON };
+// DIJKSTRA_RADIX is Dijkstra on a radix heap, or on Dial's buckets when the
+// largest weight is small; it needs non-negative integer weights.
+// DELTA_STEPPING is a parallel alternative for the same graphs. SPFA is a
+// queue-based Bellman-Ford that stops at the first negative cycle,
+// BELLMAN_FORD_PARALLEL runs the passes over flat arc arrays on threads.
+enum ShortestPathAlgo {
+  DIJKSTRA,
+  BELLMAN_FORD,
+  FLOYD_WARSHALL,
+  JOHNSON,
+  DIJKSTRA_RADIX,
+  DELTA_STEPPING,
+  SPFA,
+  BELLMAN_FORD_PARALLEL
+};
 
+// num_threads is used by the parallel algorithms, 0 means hardware
+// concurrency.
 template <typename T>
 std::vector<typename Graph<T>::Edge>
-ShortestPathOneSource(Graph<T> *graph, T *source, ShortestPathAlgo algo) {
+ShortestPathOneSource(Graph<T> *graph, T *source, ShortestPathAlgo algo,
+                      size_t num_threads = 0) {
   switch (algo) {
   case ShortestPathAlgo::DIJKSTRA:
     return ShortestPathOneSourceDIJKSTRA(graph, source);
@@ -288,20 +1195,33 @@ ShortestPathOneSource(Graph<T> *graph, T *source, ShortestPathAlgo algo) {
     return ShortestPathOneSourceFLOYD_WARSHALL(graph, source);
   case ShortestPathAlgo::JOHNSON:
     return ShortestPathOneSourceJOHNSON(graph, source);
+  case ShortestPathAlgo::DIJKSTRA_RADIX:
+    return ShortestPathOneSourceDIJKSTRA_RADIX(graph, source);
+  case ShortestPathAlgo::DELTA_STEPPING:
+    return ShortestPathOneSourceDELTA_STEPPING(graph, source, num_threads);
+  case ShortestPathAlgo::SPFA:
+    return ShortestPathOneSourceSPFA(graph, source);
+  case ShortestPathAlgo::BELLMAN_FORD_PARALLEL:
+    return ShortestPathOneSourceBELLMAN_FORD_PARALLEL(graph, source,
+                                                      num_threads);
   default:
     std::cerr
         << "Invalid algorithm for one source shortest path. Valid options are "
-           "DIJKSTRA, BELLMAN_FORD, FLOYD_WARSHALL, and JOHNSON."
+           "DIJKSTRA, BELLMAN_FORD, FLOYD_WARSHALL, JOHNSON, DIJKSTRA_RADIX, "
+           "DELTA_STEPPING, SPFA and BELLMAN_FORD_PARALLEL."
         << std::endl;
     return {};
   }
   return {};
 }
 
+// FLOYD_WARSHALL runs independent tiles and JOHNSON its per-source
+// Dijkstras on num_threads threads, 0 means hardware concurrency.
 template <typename T>
 std::unordered_map<typename Graph<T>::Pointer,
                    std::vector<typename Graph<T>::Edge>>
-ShortestPathAllPairs(Graph<T> *graph, ShortestPathAlgo algo) {
+ShortestPathAllPairs(Graph<T> *graph, ShortestPathAlgo algo,
+                     size_t num_threads = 0) {
   std::unordered_set<ShortestPathAlgo> valid_algos = {
       ShortestPathAlgo::FLOYD_WARSHALL, ShortestPathAlgo::JOHNSON};
   if (valid_algos.find(algo) == valid_algos.end()) {
@@ -312,10 +1232,132 @@ ShortestPathAllPairs(Graph<T> *graph, ShortestPathAlgo algo) {
   }
 
   if (algo == ShortestPathAlgo::FLOYD_WARSHALL) {
-    return ShortestPathAllPairsFLOYD_WARSHALL(graph);
+    return ShortestPathAllPairsFLOYD_WARSHALL(graph, num_threads);
   } else {
-    return ShortestPathAllPairsJOHNSON(graph);
+    return ShortestPathAllPairsJOHNSON(graph, num_threads);
+  }
+}
+
+// Edges of a negative-weight cycle in cycle order, each edge's to is the
+// next edge's from. With a source only cycles reachable from it count,
+// without one any cycle of the graph does. Empty if there is none. An
+// undirected edge of negative weight is a cycle of two arcs.
+template <typename T>
+std::vector<typename Graph<T>::Edge> FindNegativeCycle(Graph<T> *graph,
+                                                       T *source = nullptr) {
+  if (!graph)
+    return {};
+  CompactGraph<T> cg(graph);
+  int s = -1;
+  if (source != nullptr) {
+    s = cg.indexOf(source);
+    if (s < 0)
+      return {};
+  }
+  std::vector<typename Graph<T>::Edge> tree;
+  std::vector<typename Graph<T>::Edge> cycle;
+  shortestPathSPFA(cg, s, tree, cycle);
+  return cycle;
+}
+
+// Johnson's reweighting kept for repeated queries on one graph. build()
+// snapshots the graph and computes the potentials once with Bellman-Ford;
+// every later query is a Dijkstra on the reduced weights. Like
+// CompactGraph it does not see later changes of the graph; call build()
+// again after modifying it.
+template <typename T> class JohnsonShortestPaths {
+public:
+  typedef typename Graph<T>::Pointer Pointer;
+  typedef typename Graph<T>::Edge Edge;
+
+  JohnsonShortestPaths() = default;
+  explicit JohnsonShortestPaths(const Graph<T> *graph) { build(graph); }
+
+  // false if the graph is nullptr or has a negative cycle
+  bool build(const Graph<T> *graph) {
+    valid_ = false;
+    potential_.clear();
+    reduced_.clear();
+    if (graph == nullptr) {
+      std::cerr << "input graph is nullptr" << std::endl;
+      return false;
+    }
+    cg_.build(graph);
+    if (!johnsonPotentials(cg_, potential_)) {
+      std::cerr << "Graph contains a negative-weight cycle" << std::endl;
+      potential_.clear();
+      return false;
+    }
+    reduced_ = johnsonReducedWeights(cg_, potential_);
+    valid_ = true;
+    return true;
   }
+
+  bool valid() const { return valid_; }
+
+  // potential of a vertex, 0 if it is unknown
+  long long potential(Pointer v) const {
+    const int i = cg_.indexOf(v);
+    return valid_ && i >= 0 ? potential_[i] : 0;
+  }
+
+  // shortest path tree from source, edges in vertex order
+  std::vector<Edge> oneSource(Pointer source) const {
+    const int s = cg_.indexOf(source);
+    if (!valid_ || s < 0) {
+      return {};
+    }
+    std::vector<std::uint64_t> dist;
+    return johnsonOneSource(cg_, potential_, reduced_, s, dist);
+  }
+
+  std::unordered_map<Pointer, std::vector<Edge>>
+  allPairs(size_t num_threads = 0) const {
+    if (!valid_) {
+      return {};
+    }
+    return johnsonAllPairs(cg_, potential_, reduced_, num_threads);
+  }
+
+private:
+  CompactGraph<T> cg_;
+  std::vector<long long> potential_;
+  std::vector<std::uint64_t> reduced_;
+  bool valid_ = false;
+};
+
+// A point-to-point shortest path: the edges from source to target in order
+// and their total weight. found is false if target is not reachable;
+// settled counts the vertexs both searches of ShortestPath settled.
+template <typename T> struct ShortestPathResult {
+  std::vector<typename Graph<T>::Edge> edges;
+  long long cost = 0;
+  bool found = false;
+  size_t settled = 0;
+};
+
+// Shortest source -> target path by bidirectional Dijkstra; needs
+// non-negative weights. source == target gives an empty path of cost 0.
+template <typename T>
+ShortestPathResult<T> ShortestPath(const Graph<T> *graph, T *source,
+                                   T *target) {
+  ShortestPathResult<T> res;
+  if (!graph || !source || !target)
+    return res;
+  if (graph->getIndegrees(source) < 0 || graph->getIndegrees(target) < 0) {
+    return res;
+  }
+  if (graph->hasNegativeWeight()) {
+    std::cerr << "DIJKSTRA cannot handle negative weight edges" << std::endl;
+    return res;
+  }
+  if (source == target) {
+    res.found = true;
+    return res;
+  }
+  res.found = bidirectionalDijkstra(graph, source, target, res.edges,
+                                    res.cost, res.settled);
+  return res;
 }
 
 enum KShortestPathAlgo { A_STAR };
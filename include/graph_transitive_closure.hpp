@@ -0,0 +1,163 @@
+#pragma once
+#include "graph.hpp"
+#include "graph_connected_component.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+// dst |= src over n 64-bit words
+inline void orBitsetWords(std::uint64_t *dst, const std::uint64_t *src,
+                          size_t n) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 4 <= n; i += 4) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        _mm256_or_si256(a, b));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] |= src[i];
+  }
+}
+} // namespace
+
+namespace graphTest {
+
+// Full reachability matrix of a directed graph, meant for graphs up to a few
+// tens of thousands of vertices. SCCs are condensed first and one bitset row
+// is kept per component, so reaches(u, v) is a single bit test. Every vertex
+// reaches itself.
+template <typename DataT> class TransitiveClosure {
+public:
+  typedef typename Graph<DataT>::Pointer Pointer;
+
+  TransitiveClosure() = default;
+
+  // bytes needed by the matrix of a graph with num_components SCCs
+  static size_t estimateMemoryBytes(size_t num_components) {
+    const size_t words = (num_components + 63) / 64;
+    return num_components * words * sizeof(std::uint64_t);
+  }
+
+  // upper bound before condensation: assumes every vertex is its own SCC
+  static size_t estimateMemoryBytes(const Graph<DataT> *g) {
+    return g == nullptr ? 0 : estimateMemoryBytes(g->numVertexs());
+  }
+
+  // Builds the closure. Returns false, leaving the object empty, if the
+  // graph is invalid or the condensed matrix would exceed max_bytes.
+  bool build(const Graph<DataT> *g,
+             size_t max_bytes = std::numeric_limits<size_t>::max()) {
+    clear();
+    if (g == nullptr) {
+      std::cerr << "input graph is nullptr" << std::endl;
+      return false;
+    }
+    if (!g->isDirected()) {
+      std::cerr << "transitive closure is for directed graph" << std::endl;
+      return false;
+    }
+
+    // Tarjan labels components in reverse topological order: every
+    // component reachable from component i has a label smaller than i.
+    TraversalWorkspace<DataT> ws(g);
+    const auto scc = getSCCLabels(g, Tarjan, ws);
+    const auto &cg = ws.graph();
+    const size_t comps = scc.count;
+    if (estimateMemoryBytes(comps) > max_bytes) {
+      std::cerr << "transitive closure needs " << estimateMemoryBytes(comps)
+                << " bytes, limit is " << max_bytes << std::endl;
+      return false;
+    }
+    comp_of_.reserve(cg.numVertexs());
+    for (size_t i = 0; i < cg.numVertexs(); ++i) {
+      comp_of_[cg.vertexAt(static_cast<int>(i))] = scc.label[i];
+    }
+    std::vector<int> offsets, members;
+    scc.getMembers(offsets, members);
+
+    num_comps_ = comps;
+    words_ = (comps + 63) / 64;
+    bits_.assign(comps * words_, 0);
+    std::vector<int> succ;
+    for (size_t c = 0; c < comps; ++c) {
+      std::uint64_t *row = bits_.data() + c * words_;
+      row[c / 64] |= std::uint64_t(1) << (c % 64);
+      succ.clear();
+      for (int i = offsets[c]; i < offsets[c + 1]; ++i) {
+        const int u = members[i];
+        for (size_t arc = cg.outBegin(u); arc < cg.outEnd(u); ++arc) {
+          const int d = scc.label[cg.outTargets()[arc]];
+          if (static_cast<size_t>(d) != c) {
+            succ.push_back(d);
+          }
+        }
+      }
+      // later (closer to c) components first, so more rows are skipped
+      std::sort(succ.begin(), succ.end(), std::greater<int>());
+      succ.erase(std::unique(succ.begin(), succ.end()), succ.end());
+      for (int d : succ) {
+        // an already set bit means row d is contained in row c
+        if (row[d / 64] & (std::uint64_t(1) << (d % 64))) {
+          continue;
+        }
+        orBitsetWords(row, bits_.data() + d * words_, words_);
+      }
+    }
+    return true;
+  }
+
+  bool reaches(Pointer u, Pointer v) const {
+    auto iu = comp_of_.find(u);
+    auto iv = comp_of_.find(v);
+    if (iu == comp_of_.end() || iv == comp_of_.end()) {
+      return false;
+    }
+    const size_t d = iv->second;
+    return (bits_[iu->second * words_ + d / 64] >> (d % 64)) & 1;
+  }
+
+  // vertexs reachable from u, u included
+  std::vector<Pointer> reachableFrom(Pointer u) const {
+    std::vector<Pointer> res;
+    if (comp_of_.find(u) == comp_of_.end()) {
+      return res;
+    }
+    for (const auto &pair : comp_of_) {
+      if (reaches(u, pair.first)) {
+        res.push_back(pair.first);
+      }
+    }
+    return res;
+  }
+
+  bool empty() const { return comp_of_.empty(); }
+  size_t numComponents() const { return num_comps_; }
+  size_t memoryBytes() const { return bits_.size() * sizeof(std::uint64_t); }
+
+private:
+  void clear() {
+    comp_of_.clear();
+    bits_.clear();
+    num_comps_ = 0;
+    words_ = 0;
+  }
+
+  std::unordered_map<Pointer, int> comp_of_;
+  // row-major, words_ 64-bit words per component
+  std::vector<std::uint64_t> bits_;
+  size_t num_comps_ = 0;
+  size_t words_ = 0;
+};
+
+} // namespace graphTest
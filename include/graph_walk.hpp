@@ -1,8 +1,12 @@
 #pragma once
 #include "basicAlgo.hpp"
+#include "generator.hpp"
 #include "graph.hpp"
 #include <functional>
 #include <iostream>
+#include <queue>
+#include <unordered_set>
+#include <vector>
 namespace graphTest {
 enum WalkAlgo {
   BFS_PREORDER,
@@ -11,92 +15,179 @@ enum WalkAlgo {
   DFS_POSTORDER,
 };
 
+namespace {
+// default start nodes of a walk: zero indegree vertexs, or zero outdegree
+// ones for a reverse walk. Returns false for undirected graphs, which have
+// no such notion.
+template <typename DataT>
+bool collectWalkStarts(Graph<DataT> *g, bool reverse,
+                       std::vector<DataT *> &starts) {
+  if (!starts.empty()) {
+    return true;
+  }
+  if (!g->isDirected()) {
+    std::cerr << "walk on undirected graph must provide start nodes"
+              << std::endl;
+    return false;
+  }
+  for (const auto &data : g->getAllVertexs()) {
+    if (!reverse && g->getIndegrees(data) == 0) {
+      starts.push_back(data);
+    } else if (reverse && g->getOutdegrees(data) == 0) {
+      starts.push_back(data);
+    }
+  }
+  return true;
+}
+
+template <typename DataT>
+std::function<std::vector<DataT *>(DataT *)> walkNexts(Graph<DataT> *g,
+                                                       bool reverse) {
+  return [g, reverse](DataT *data) {
+    return reverse ? g->getPrev(data) : g->getNext(data);
+  };
+}
+} // namespace
+
 template <typename DataT>
 void Walk(WalkAlgo algo, Graph<DataT> *g, bool reverse,
           const std::function<void(DataT *)> &walker,
           std::vector<DataT *> starts = {}) {
-  if (starts.empty() && !g->isDirected()) {
-    std::cerr << "walk on undirected graph must provide start nodes"
-              << std::endl;
+  if (!collectWalkStarts(g, reverse, starts)) {
     return;
-  } else if (starts.empty()) {
-    if (!reverse) {
-      // collect all nodes with zero indegree as start nodes
-      for (const auto &data : g->getAllVertexs()) {
-        if (g->getIndegrees(data) == 0) {
-          starts.push_back(data);
-        }
-      }
-    } else {
-      // collect all nodes with zero outdegree as start nodes
-      for (const auto &data : g->getAllVertexs()) {
-        if (g->getOutdegrees(data) == 0) {
-          starts.push_back(data);
-        }
-      }
-    }
   }
+  std::function<std::vector<DataT *>(DataT *)> getNexts =
+      walkNexts(g, reverse);
   switch (algo) {
-  case BFS_PREORDER: {
-    std::function<std::vector<DataT *>(DataT *)> getNexts =
-        [g, reverse](DataT *data) {
-          std::vector<DataT *> nexts;
-          if (reverse) {
-            nexts = g->getPrev(data);
-          } else {
-            nexts = g->getNext(data);
-          }
-          return nexts;
-        };
+  case BFS_PREORDER:
     BFS<DataT>(starts, getNexts, walker, nullptr);
     break;
-  }
-  case BFS_POSTORDER: {
-    std::function<std::vector<DataT *>(DataT *)> getNexts =
-        [g, reverse](DataT *data) {
-          std::vector<DataT *> nexts;
-          if (reverse) {
-            nexts = g->getPrev(data);
-          } else {
-            nexts = g->getNext(data);
-          }
-          return nexts;
-        };
+  case BFS_POSTORDER:
     BFS<DataT>(starts, getNexts, nullptr, walker);
     break;
-  }
-  case DFS_PREORDER: {
-    std::function<std::vector<DataT *>(DataT *)> getNexts =
-        [g, reverse](DataT *data) {
-          std::vector<DataT *> nexts;
-          if (reverse) {
-            nexts = g->getPrev(data);
-          } else {
-            nexts = g->getNext(data);
-          }
-          return nexts;
-        };
+  case DFS_PREORDER:
     DFS<DataT>(starts, getNexts, walker, nullptr);
     break;
-  }
-  case DFS_POSTORDER: {
-    std::function<std::vector<DataT *>(DataT *)> getNexts =
-        [g, reverse](DataT *data) {
-          std::vector<DataT *> nexts;
-          if (reverse) {
-            nexts = g->getPrev(data);
-          } else {
-            nexts = g->getNext(data);
-          }
-          return nexts;
-        };
+  case DFS_POSTORDER:
     DFS<DataT>(starts, getNexts, nullptr, walker);
     break;
+  default:
+    std::cerr << "Unknown walk algorithm!" << std::endl;
+    break;
+  }
+}
+
+// Lazy Walk: yields the vertexs Walk would pass to its walker, in the same
+// order, only as far as the caller iterates. BFS_POSTORDER is the reverse
+// of the BFS order and therefore has to finish the BFS before yielding.
+template <typename DataT>
+Generator<DataT *> WalkLazy(WalkAlgo algo, Graph<DataT> *g, bool reverse,
+                            std::vector<DataT *> starts = {}) {
+  if (!collectWalkStarts(g, reverse, starts)) {
+    co_return;
+  }
+  auto getNexts = walkNexts(g, reverse);
+  switch (algo) {
+  case BFS_PREORDER:
+    for (DataT *v : BFSLazy<DataT>(starts, getNexts)) {
+      co_yield v;
+    }
+    break;
+  case BFS_POSTORDER: {
+    std::vector<DataT *> order = BFS<DataT>(starts, getNexts);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+      co_yield *it;
+    }
+    break;
   }
+  case DFS_PREORDER:
+  case DFS_POSTORDER:
+    for (DataT *v : DFSLazy<DataT>(starts, getNexts, algo == DFS_POSTORDER)) {
+      co_yield v;
+    }
+    break;
   default:
     std::cerr << "Unknown walk algorithm!" << std::endl;
     break;
   }
 }
 
+// Yields the tree edges of a BFS_PREORDER or DFS_PREORDER walk in discovery
+// order. Edges keep their direction in the graph, so on a reverse walk an
+// edge points from the newly discovered vertex to its tree parent.
+template <typename DataT>
+Generator<typename Graph<DataT>::Edge>
+WalkEdgesLazy(WalkAlgo algo, Graph<DataT> *g, bool reverse,
+              std::vector<DataT *> starts = {}) {
+  using Edge = typename Graph<DataT>::Edge;
+  if (algo != BFS_PREORDER && algo != DFS_PREORDER) {
+    std::cerr << "edge walk supports BFS_PREORDER and DFS_PREORDER"
+              << std::endl;
+    co_return;
+  }
+  if (!collectWalkStarts(g, reverse, starts)) {
+    co_return;
+  }
+  auto tree_child = [reverse](const Edge &e) {
+    return reverse ? e.from.get_data() : e.to.get_data();
+  };
+  std::unordered_set<DataT *> visited;
+  std::vector<Edge> edges;
+
+  if (algo == BFS_PREORDER) {
+    std::queue<DataT *> q;
+    for (auto start : starts) {
+      if (start != nullptr && visited.insert(start).second) {
+        q.push(start);
+      }
+    }
+    while (!q.empty()) {
+      DataT *curr = q.front();
+      q.pop();
+      reverse ? g->getInEdges(curr, edges) : g->getOutEdges(curr, edges);
+      for (const auto &e : edges) {
+        DataT *child = tree_child(e);
+        if (visited.insert(child).second) {
+          q.push(child);
+          co_yield e;
+        }
+      }
+    }
+    co_return;
+  }
+
+  // DFS: every stack entry remembers the edge that pushed it
+  struct Entry {
+    DataT *node;
+    DataT *parent;
+    int weight;
+  };
+  std::vector<Entry> stk;
+  for (auto start : starts) {
+    if (start != nullptr) {
+      stk.push_back({start, nullptr, 0});
+    }
+  }
+  while (!stk.empty()) {
+    Entry curr = stk.back();
+    stk.pop_back();
+    if (!visited.insert(curr.node).second) {
+      continue;
+    }
+    if (curr.parent != nullptr) {
+      Edge e = reverse ? Edge(curr.node, curr.parent, curr.weight)
+                       : Edge(curr.parent, curr.node, curr.weight);
+      co_yield e;
+    }
+    reverse ? g->getInEdges(curr.node, edges)
+            : g->getOutEdges(curr.node, edges);
+    for (auto it = edges.rbegin(); it != edges.rend(); ++it) {
+      DataT *child = tree_child(*it);
+      if (visited.count(child) == 0) {
+        stk.push_back({child, curr.node, it->weight_});
+      }
+    }
+  }
+}
+
 } // namespace graphTest
\ No newline at end of file
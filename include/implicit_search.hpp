@@ -0,0 +1,446 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace graphTest {
+
+// A search problem over an implicit state space: states are produced by a
+// successor function instead of being stored in a Graph, so spaces far
+// larger than memory can be searched.
+//   successors(s, out) fills `out` with (next state, step cost >= 0) pairs,
+//   like Graph::getOutEdges fills its result vector.
+//   heuristic(s) must not overestimate the remaining cost for A* and IDA*
+//   to return optimal paths. Leaving it empty means h = 0.
+template <typename State, typename Hash = std::hash<State>,
+          typename Equal = std::equal_to<State>>
+struct SearchProblem {
+  typedef std::function<void(const State &,
+                             std::vector<std::pair<State, int>> &)>
+      Successors;
+  State start;
+  std::function<bool(const State &)> isGoal;
+  Successors successors;
+  std::function<long long(const State &)> heuristic = nullptr;
+  Hash hash = Hash();
+  Equal equal = Equal();
+};
+
+template <typename State> struct SearchResult {
+  bool found = false;
+  long long cost = 0;
+  std::vector<State> path; // start ... goal
+  size_t expanded = 0;     // states whose successors were generated
+  size_t generated = 0;    // successor states produced
+  size_t stored = 0;       // most states held in memory at once
+};
+
+struct ImplicitSearchOptions {
+  // stop (found = false) after this many expansions
+  size_t max_expansions = SIZE_MAX;
+  // states kept per layer by BEAM
+  size_t beam_width = 64;
+};
+
+enum class ImplicitSearchAlgo { A_STAR, IDA_STAR, BEAM };
+
+} // namespace graphTest
+
+namespace {
+namespace gt = graphTest;
+
+// Open-addressing table from state to arena index. A slot holds only the
+// 64-bit hash and a 32-bit arena index; the state itself lives once in the
+// node arena and is compared only when the hashes match.
+class StateIndexTable {
+public:
+  StateIndexTable() { rehash(1024); }
+
+  // arena index of a state with hash h for which same(index) holds, or -1
+  template <typename Same> std::int64_t find(std::uint64_t h, Same same) const {
+    const std::uint64_t key = normalize(h);
+    for (size_t i = key & mask_;; i = (i + 1) & mask_) {
+      if (keys_[i] == 0) {
+        return -1;
+      }
+      if (keys_[i] == key && same(index_[i])) {
+        return index_[i];
+      }
+    }
+  }
+
+  void insert(std::uint64_t h, std::uint32_t index) {
+    if ((size_ + 1) * 10 > keys_.size() * 7) {
+      rehash(keys_.size() * 2);
+    }
+    place(normalize(h), index);
+    ++size_;
+  }
+
+  size_t size() const { return size_; }
+
+  void clear() {
+    std::fill(keys_.begin(), keys_.end(), 0);
+    size_ = 0;
+  }
+
+private:
+  // std::hash of integers is the identity, which makes long probe runs with
+  // linear probing; mix the bits first. 0 marks an empty slot.
+  static std::uint64_t normalize(std::uint64_t h) {
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h == 0 ? 1 : h;
+  }
+
+  void place(std::uint64_t key, std::uint32_t index) {
+    size_t i = key & mask_;
+    while (keys_[i] != 0) {
+      i = (i + 1) & mask_;
+    }
+    keys_[i] = key;
+    index_[i] = index;
+  }
+
+  void rehash(size_t capacity) {
+    std::vector<std::uint64_t> old_keys(capacity, 0);
+    std::vector<std::uint32_t> old_index(capacity, 0);
+    old_keys.swap(keys_);
+    old_index.swap(index_);
+    mask_ = capacity - 1;
+    for (size_t i = 0; i < old_keys.size(); ++i) {
+      if (old_keys[i] != 0) {
+        place(old_keys[i], old_index[i]);
+      }
+    }
+  }
+
+  std::vector<std::uint64_t> keys_;
+  std::vector<std::uint32_t> index_;
+  size_t mask_ = 0;
+  size_t size_ = 0;
+};
+
+template <typename State> struct SearchNode {
+  State state;
+  long long g;
+  std::int64_t parent;
+};
+
+template <typename State>
+void buildSearchPath(const std::vector<SearchNode<State>> &arena,
+                     std::int64_t goal, gt::SearchResult<State> &res) {
+  res.found = true;
+  res.cost = arena[goal].g;
+  for (std::int64_t i = goal; i != -1; i = arena[i].parent) {
+    res.path.push_back(arena[i].state);
+  }
+  std::reverse(res.path.begin(), res.path.end());
+}
+
+template <typename State, typename Hash, typename Equal>
+long long searchHeuristic(const gt::SearchProblem<State, Hash, Equal> &p,
+                          const State &s) {
+  return p.heuristic ? p.heuristic(s) : 0;
+}
+
+template <typename State, typename Hash, typename Equal>
+gt::SearchResult<State>
+AStarSearch(const gt::SearchProblem<State, Hash, Equal> &p,
+            const gt::ImplicitSearchOptions &opt) {
+  gt::SearchResult<State> res;
+  std::vector<SearchNode<State>> arena;
+  StateIndexTable table;
+  // (f, g, arena index); entries whose g is stale are skipped when popped,
+  // which also handles re-opening under an inconsistent heuristic
+  typedef std::tuple<long long, long long, std::int64_t> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+  arena.push_back({p.start, 0, -1});
+  table.insert(p.hash(p.start), 0);
+  open.push({searchHeuristic(p, p.start), 0, 0});
+  res.stored = 1;
+  std::vector<std::pair<State, int>> nexts;
+
+  while (!open.empty()) {
+    auto [f, g, idx] = open.top();
+    open.pop();
+    if (g != arena[idx].g) {
+      continue;
+    }
+    if (p.isGoal(arena[idx].state)) {
+      buildSearchPath(arena, idx, res);
+      return res;
+    }
+    if (res.expanded == opt.max_expansions) {
+      break;
+    }
+    ++res.expanded;
+    nexts.clear();
+    p.successors(arena[idx].state, nexts);
+    for (auto &next : nexts) {
+      if (next.second < 0) {
+        std::cerr << "implicit search ignores negative step cost" << std::endl;
+        continue;
+      }
+      ++res.generated;
+      const long long ng = g + next.second;
+      const std::uint64_t h = p.hash(next.first);
+      const std::int64_t known = table.find(h, [&](std::uint32_t i) {
+        return p.equal(arena[i].state, next.first);
+      });
+      if (known >= 0) {
+        if (ng >= arena[known].g) {
+          continue;
+        }
+        arena[known].g = ng;
+        arena[known].parent = idx;
+        open.push({ng + searchHeuristic(p, arena[known].state), ng, known});
+        continue;
+      }
+      const std::int64_t ni = static_cast<std::int64_t>(arena.size());
+      const long long nh = searchHeuristic(p, next.first);
+      arena.push_back({std::move(next.first), ng, idx});
+      table.insert(h, static_cast<std::uint32_t>(ni));
+      open.push({ng + nh, ng, ni});
+      res.stored = arena.size();
+    }
+  }
+  return res;
+}
+
+// IDA*: depth-first searches bounded by f = g + h with a growing bound.
+// Memory is linear in the path length; only the states on the current path
+// are remembered (to skip cycles), so no closed set is needed at all.
+template <typename State, typename Hash, typename Equal>
+gt::SearchResult<State>
+IDAStarSearch(const gt::SearchProblem<State, Hash, Equal> &p,
+              const gt::ImplicitSearchOptions &opt) {
+  gt::SearchResult<State> res;
+  struct Frame {
+    State state;
+    long long g;
+    std::vector<std::pair<State, int>> nexts;
+    size_t next_pos;
+  };
+  std::unordered_multiset<std::uint64_t> on_path;
+  auto onPath = [&](const State &s, std::uint64_t h,
+                    const std::vector<Frame> &stk) {
+    if (on_path.count(h) == 0) {
+      return false;
+    }
+    for (const auto &f : stk) {
+      if (p.equal(f.state, s)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  long long bound = searchHeuristic(p, p.start);
+  std::vector<Frame> stk;
+  while (true) {
+    long long next_bound = LLONG_MAX;
+    stk.clear();
+    on_path.clear();
+    stk.push_back({p.start, 0, {}, 0});
+    res.stored = std::max<size_t>(res.stored, 1);
+    on_path.insert(p.hash(p.start));
+    bool fresh = true; // the top frame has not been expanded yet
+    while (!stk.empty()) {
+      Frame &top = stk.back();
+      if (fresh) {
+        fresh = false;
+        const long long f = top.g + searchHeuristic(p, top.state);
+        if (f > bound) {
+          next_bound = std::min(next_bound, f);
+          on_path.erase(on_path.find(p.hash(top.state)));
+          stk.pop_back();
+          continue;
+        }
+        if (p.isGoal(top.state)) {
+          res.found = true;
+          res.cost = top.g;
+          for (const auto &frame : stk) {
+            res.path.push_back(frame.state);
+          }
+          return res;
+        }
+        if (res.expanded == opt.max_expansions) {
+          return res;
+        }
+        ++res.expanded;
+        p.successors(top.state, top.nexts);
+        res.generated += top.nexts.size();
+      }
+      if (top.next_pos == top.nexts.size()) {
+        on_path.erase(on_path.find(p.hash(top.state)));
+        stk.pop_back();
+        continue;
+      }
+      auto &next = top.nexts[top.next_pos++];
+      if (next.second < 0) {
+        std::cerr << "implicit search ignores negative step cost" << std::endl;
+        continue;
+      }
+      const std::uint64_t h = p.hash(next.first);
+      if (onPath(next.first, h, stk)) {
+        continue;
+      }
+      const long long ng = top.g + next.second;
+      on_path.insert(h);
+      stk.push_back({std::move(next.first), ng, {}, 0});
+      res.stored = std::max(res.stored, stk.size());
+      fresh = true;
+    }
+    if (next_bound == LLONG_MAX) {
+      return res; // the whole space fits under the bound, no goal
+    }
+    bound = next_bound;
+  }
+}
+
+// Beam search: breadth-first by layers, keeping only the beam_width states
+// with the smallest g + h per layer. Neither complete nor optimal, but only
+// the states that survive the cut are stored, so memory stays at about
+// depth * beam_width states plus one layer of candidates. States kept in
+// earlier layers are not revisited; pruned ones may be generated again.
+template <typename State, typename Hash, typename Equal>
+gt::SearchResult<State>
+BeamSearch(const gt::SearchProblem<State, Hash, Equal> &p,
+           const gt::ImplicitSearchOptions &opt) {
+  gt::SearchResult<State> res;
+  if (opt.beam_width == 0) {
+    return res;
+  }
+  std::vector<SearchNode<State>> arena;
+  StateIndexTable table;
+  arena.push_back({p.start, 0, -1});
+  table.insert(p.hash(p.start), 0);
+  res.stored = 1;
+  if (p.isGoal(p.start)) {
+    buildSearchPath(arena, 0, res);
+    return res;
+  }
+
+  struct Candidate {
+    long long f;
+    long long g;
+    std::int64_t parent;
+    std::uint64_t hash;
+    State state;
+  };
+  std::vector<std::int64_t> layer = {0};
+  std::vector<Candidate> candidates;
+  StateIndexTable seen; // candidate index by state, for this layer only
+  std::vector<std::pair<State, int>> nexts;
+  while (!layer.empty()) {
+    candidates.clear();
+    seen.clear();
+    std::int64_t best_goal = -1;
+    for (std::int64_t idx : layer) {
+      if (res.expanded == opt.max_expansions) {
+        return res;
+      }
+      ++res.expanded;
+      nexts.clear();
+      p.successors(arena[idx].state, nexts);
+      for (auto &next : nexts) {
+        if (next.second < 0) {
+          std::cerr << "implicit search ignores negative step cost"
+                    << std::endl;
+          continue;
+        }
+        ++res.generated;
+        const std::uint64_t h = p.hash(next.first);
+        if (table.find(h, [&](std::uint32_t i) {
+              return p.equal(arena[i].state, next.first);
+            }) >= 0) {
+          continue;
+        }
+        const long long ng = arena[idx].g + next.second;
+        const std::int64_t known = seen.find(h, [&](std::uint32_t i) {
+          return p.equal(candidates[i].state, next.first);
+        });
+        if (known >= 0) {
+          Candidate &c = candidates[known];
+          if (ng < c.g) {
+            c.f += ng - c.g;
+            c.g = ng;
+            c.parent = idx;
+          }
+          continue;
+        }
+        const std::int64_t ci = static_cast<std::int64_t>(candidates.size());
+        const long long f = ng + searchHeuristic(p, next.first);
+        candidates.push_back({f, ng, idx, h, std::move(next.first)});
+        seen.insert(h, static_cast<std::uint32_t>(ci));
+        if (p.isGoal(candidates[ci].state) &&
+            (best_goal == -1 || ng < candidates[best_goal].g)) {
+          best_goal = ci;
+        }
+      }
+    }
+    if (best_goal != -1) {
+      Candidate &c = candidates[best_goal];
+      arena.push_back({std::move(c.state), c.g, c.parent});
+      res.stored = arena.size();
+      buildSearchPath(arena, static_cast<std::int64_t>(arena.size()) - 1, res);
+      return res;
+    }
+    auto byF = [](const Candidate &a, const Candidate &b) { return a.f < b.f; };
+    if (candidates.size() > opt.beam_width) {
+      std::nth_element(candidates.begin(),
+                       candidates.begin() + opt.beam_width, candidates.end(),
+                       byF);
+      candidates.resize(opt.beam_width);
+    }
+    layer.clear();
+    for (auto &c : candidates) {
+      const std::int64_t ni = static_cast<std::int64_t>(arena.size());
+      table.insert(c.hash, static_cast<std::uint32_t>(ni));
+      arena.push_back({std::move(c.state), c.g, c.parent});
+      layer.push_back(ni);
+    }
+    res.stored = arena.size();
+  }
+  return res;
+}
+} // namespace
+
+namespace graphTest {
+
+template <typename State, typename Hash, typename Equal>
+SearchResult<State>
+ImplicitSearch(const SearchProblem<State, Hash, Equal> &problem,
+               ImplicitSearchAlgo algo,
+               const ImplicitSearchOptions &options = ImplicitSearchOptions()) {
+  if (!problem.isGoal || !problem.successors) {
+    std::cerr << "search problem needs isGoal and successors" << std::endl;
+    return {};
+  }
+  switch (algo) {
+  case ImplicitSearchAlgo::A_STAR:
+    return AStarSearch(problem, options);
+  case ImplicitSearchAlgo::IDA_STAR:
+    return IDAStarSearch(problem, options);
+  case ImplicitSearchAlgo::BEAM:
+    return BeamSearch(problem, options);
+  default:
+    std::cerr << "unknown implicit search algorithm" << std::endl;
+    return {};
+  }
+}
+
+} // namespace graphTest
@@ -0,0 +1,314 @@
+#pragma once
+#include "graph.hpp"
+#include "graph_mst.hpp"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graphTest {
+
+// Minimum spanning forest maintained under edge insertions and weight
+// decreases. The forest is stored in a link-cut tree where every tree edge
+// is a node of its own carrying the weight, so the heaviest edge on a tree
+// path is found in O(log n) amortized. An edge between two trees links
+// them; an edge inside a tree replaces the heaviest edge on the cycle it
+// closes if it is lighter. Edges that are dropped can never come back
+// under these updates, so only the tree edges are stored.
+template <typename T> class IncrementalMST {
+public:
+  typedef typename Graph<T>::Pointer Pointer;
+  typedef typename Graph<T>::Edge Edge;
+
+  IncrementalMST() = default;
+
+  // starts from the minimum spanning forest of an undirected graph
+  explicit IncrementalMST(const Graph<T> *graph) {
+    if (graph == nullptr || graph->isDirected()) {
+      std::cerr << "IncrementalMST needs an undirected graph" << std::endl;
+      return;
+    }
+    for (Pointer v : graph->getAllVertexs()) {
+      idOf(v);
+    }
+    for (const auto &e : getMSTForest(graph).edges) {
+      insertEdge(e.from.get_data(), e.to.get_data(), e.weight_);
+    }
+  }
+
+  void addVertex(Pointer data) { idOf(data); }
+
+  // Adds the edge u - v. Returns true if it entered the forest.
+  bool insertEdge(Pointer u, Pointer v, int weight) {
+    if (u == nullptr || v == nullptr || u == v) {
+      return false;
+    }
+    const int a = idOf(u);
+    const int b = idOf(v);
+    auto it = tree_edge_.find(key(a, b));
+    if (it != tree_edge_.end()) {
+      // a parallel copy of a tree edge only matters if it is lighter
+      return lowerTreeEdge(it->second, weight);
+    }
+    if (!connected(vertex_node_[a], vertex_node_[b])) {
+      linkEdge(a, b, weight);
+      return true;
+    }
+    const int heaviest = pathMax(vertex_node_[a], vertex_node_[b]);
+    if (nodes_[heaviest].w <= weight) {
+      return false;
+    }
+    cutEdge(heaviest);
+    linkEdge(a, b, weight);
+    return true;
+  }
+
+  // The edge u - v now weighs weight, which must not be above its old
+  // weight. A tree edge is updated in place, any other edge is treated as
+  // an insertion. Returns true if the forest changed.
+  bool decreaseWeight(Pointer u, Pointer v, int weight) {
+    return insertEdge(u, v, weight);
+  }
+
+  // total weight of the current forest, O(1)
+  long long weight() const { return weight_; }
+  size_t numTreeEdges() const { return tree_edge_.size(); }
+  size_t numVertexs() const { return vertex_node_.size(); }
+  size_t numTrees() const { return vertex_node_.size() - tree_edge_.size(); }
+
+  bool connected(Pointer u, Pointer v) {
+    auto iu = id_map_.find(u);
+    auto iv = id_map_.find(v);
+    if (iu == id_map_.end() || iv == id_map_.end()) {
+      return false;
+    }
+    return connected(vertex_node_[iu->second], vertex_node_[iv->second]);
+  }
+
+  // the current forest, edges in no particular order
+  SpanningForest<T> forest() const {
+    SpanningForest<T> res;
+    for (const auto &it : tree_edge_) {
+      const Node &e = nodes_[it.second];
+      res.add(Edge(vertexs_[e.u], vertexs_[e.v], e.w));
+    }
+    return res;
+  }
+
+private:
+  struct Node {
+    int child[2] = {-1, -1};
+    int parent = -1;
+    bool flip = false;
+    int w = INT_MIN;
+    // node of largest w in the splay subtree
+    int max = -1;
+    // endpoints of an edge node, -1 for vertex nodes
+    int u = -1;
+    int v = -1;
+  };
+
+  static std::uint64_t key(int a, int b) {
+    if (a > b) {
+      std::swap(a, b);
+    }
+    return (static_cast<std::uint64_t>(a) << 32) |
+           static_cast<std::uint32_t>(b);
+  }
+
+  int idOf(Pointer data) {
+    auto it = id_map_.find(data);
+    if (it != id_map_.end()) {
+      return it->second;
+    }
+    const int id = static_cast<int>(vertexs_.size());
+    id_map_[data] = id;
+    vertexs_.push_back(data);
+    vertex_node_.push_back(newNode(INT_MIN, -1, -1));
+    return id;
+  }
+
+  int newNode(int w, int u, int v) {
+    int x;
+    if (free_nodes_.empty()) {
+      x = static_cast<int>(nodes_.size());
+      nodes_.emplace_back();
+    } else {
+      x = free_nodes_.back();
+      free_nodes_.pop_back();
+      nodes_[x] = Node();
+    }
+    nodes_[x].w = w;
+    nodes_[x].max = x;
+    nodes_[x].u = u;
+    nodes_[x].v = v;
+    return x;
+  }
+
+  void linkEdge(int a, int b, int w) {
+    const int e = newNode(w, a, b);
+    link(e, vertex_node_[a]);
+    link(e, vertex_node_[b]);
+    tree_edge_[key(a, b)] = e;
+    weight_ += w;
+  }
+
+  void cutEdge(int e) {
+    const int a = nodes_[e].u;
+    const int b = nodes_[e].v;
+    cut(e, vertex_node_[a]);
+    cut(e, vertex_node_[b]);
+    tree_edge_.erase(key(a, b));
+    weight_ -= nodes_[e].w;
+    free_nodes_.push_back(e);
+  }
+
+  bool lowerTreeEdge(int e, int w) {
+    if (nodes_[e].w <= w) {
+      return false;
+    }
+    access(e); // e is now the root of its splay tree
+    weight_ -= nodes_[e].w - w;
+    nodes_[e].w = w;
+    pull(e);
+    return true;
+  }
+
+  // link-cut tree on nodes_
+
+  bool isSplayRoot(int x) const {
+    const int p = nodes_[x].parent;
+    return p < 0 || (nodes_[p].child[0] != x && nodes_[p].child[1] != x);
+  }
+
+  void pull(int x) {
+    Node &n = nodes_[x];
+    n.max = x;
+    for (int c : n.child) {
+      if (c >= 0 && nodes_[nodes_[c].max].w > nodes_[n.max].w) {
+        n.max = nodes_[c].max;
+      }
+    }
+  }
+
+  void push(int x) {
+    Node &n = nodes_[x];
+    if (n.flip) {
+      std::swap(n.child[0], n.child[1]);
+      for (int c : n.child) {
+        if (c >= 0) {
+          nodes_[c].flip = !nodes_[c].flip;
+        }
+      }
+      n.flip = false;
+    }
+  }
+
+  void rotate(int x) {
+    const int p = nodes_[x].parent;
+    const int g = nodes_[p].parent;
+    const int dir = nodes_[p].child[1] == x ? 1 : 0;
+    const int moved = nodes_[x].child[dir ^ 1];
+    if (!isSplayRoot(p)) {
+      nodes_[g].child[nodes_[g].child[1] == p ? 1 : 0] = x;
+    }
+    nodes_[x].parent = g;
+    nodes_[x].child[dir ^ 1] = p;
+    nodes_[p].parent = x;
+    nodes_[p].child[dir] = moved;
+    if (moved >= 0) {
+      nodes_[moved].parent = p;
+    }
+    pull(p);
+    pull(x);
+  }
+
+  void splay(int x) {
+    splay_path_.clear();
+    for (int y = x;; y = nodes_[y].parent) {
+      splay_path_.push_back(y);
+      if (isSplayRoot(y)) {
+        break;
+      }
+    }
+    for (size_t i = splay_path_.size(); i-- > 0;) {
+      push(splay_path_[i]);
+    }
+    while (!isSplayRoot(x)) {
+      const int p = nodes_[x].parent;
+      if (!isSplayRoot(p)) {
+        const int g = nodes_[p].parent;
+        const bool zigzig =
+            (nodes_[g].child[1] == p) == (nodes_[p].child[1] == x);
+        rotate(zigzig ? p : x);
+      }
+      rotate(x);
+    }
+  }
+
+  // makes the root-to-x path preferred and splays x to its top
+  void access(int x) {
+    for (int last = -1, y = x; y >= 0; y = nodes_[y].parent) {
+      splay(y);
+      nodes_[y].child[1] = last;
+      pull(y);
+      last = y;
+    }
+    splay(x);
+  }
+
+  void makeRoot(int x) {
+    access(x);
+    nodes_[x].flip = !nodes_[x].flip;
+  }
+
+  int findRoot(int x) {
+    access(x);
+    int r = x;
+    push(r);
+    while (nodes_[r].child[0] >= 0) {
+      r = nodes_[r].child[0];
+      push(r);
+    }
+    splay(r);
+    return r;
+  }
+
+  bool connected(int x, int y) { return findRoot(x) == findRoot(y); }
+
+  void link(int x, int y) {
+    makeRoot(x);
+    nodes_[x].parent = y;
+  }
+
+  // x and y must be adjacent in the represented tree
+  void cut(int x, int y) {
+    makeRoot(x);
+    access(y);
+    nodes_[y].child[0] = -1;
+    nodes_[x].parent = -1;
+    pull(y);
+  }
+
+  // heaviest edge node on the tree path x .. y
+  int pathMax(int x, int y) {
+    makeRoot(x);
+    access(y);
+    return nodes_[y].max;
+  }
+
+  std::vector<Node> nodes_;
+  std::vector<int> free_nodes_;
+  std::vector<int> splay_path_;
+  std::vector<int> vertex_node_;
+  std::vector<Pointer> vertexs_;
+  std::unordered_map<Pointer, int> id_map_;
+  // tree edge key -> its node
+  std::unordered_map<std::uint64_t, int> tree_edge_;
+  long long weight_ = 0;
+};
+
+} // namespace graphTest
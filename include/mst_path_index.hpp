@@ -0,0 +1,363 @@
+#pragma once
+#include "compact_graph.hpp"
+#include "graph.hpp"
+#include "graph_mst.hpp"
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graphTest {
+
+// Path-maximum queries on a minimum spanning forest. Every tree is rooted
+// and binary lifting tables store, for each vertex and each power of two,
+// the ancestor that many levels up together with the heaviest edge on the
+// way. pathMax(u, v) is the largest edge weight on the tree path, which in
+// an MST is the smallest possible bottleneck over all u - v paths of the
+// graph. Queries take O(log n).
+template <typename T> class MSTPathIndex {
+public:
+  typedef typename Graph<T>::Pointer Pointer;
+  typedef typename Graph<T>::Edge Edge;
+
+  MSTPathIndex() = default;
+  explicit MSTPathIndex(const Graph<T> *graph) { build(graph); }
+  explicit MSTPathIndex(const std::vector<std::unique_ptr<Graph<T>>> &trees) {
+    build(trees);
+  }
+
+  // indexes the minimum spanning forest of an undirected graph
+  bool build(const Graph<T> *graph) {
+    clear();
+    if (graph == nullptr) {
+      std::cerr << "input graph is nullptr" << std::endl;
+      return false;
+    }
+    if (graph->isDirected()) {
+      std::cerr << "MST path index is for undirected graph" << std::endl;
+      return false;
+    }
+    for (Pointer v : graph->getAllVertexs()) {
+      idOf(v);
+    }
+    for (const auto &e : getMSTForest(graph).edges) {
+      addTreeEdge(e);
+    }
+    buildTables();
+    return true;
+  }
+
+  // indexes the trees returned by getMSTs
+  bool build(const std::vector<std::unique_ptr<Graph<T>>> &trees) {
+    clear();
+    for (const auto &tree : trees) {
+      if (tree == nullptr || tree->isDirected()) {
+        std::cerr << "MST path index needs undirected trees" << std::endl;
+        clear();
+        return false;
+      }
+      for (Pointer v : tree->getAllVertexs()) {
+        idOf(v);
+      }
+      for (const auto &e : tree->getAllEdges()) {
+        addTreeEdge(e);
+      }
+    }
+    buildTables();
+    return true;
+  }
+
+  size_t numVertexs() const { return vertexs_.size(); }
+  size_t numTreeEdges() const { return tree_edges_.size(); }
+  long long weight() const { return weight_; }
+
+  bool connected(Pointer u, Pointer v) const {
+    auto iu = index_of_.find(u);
+    auto iv = index_of_.find(v);
+    return iu != index_of_.end() && iv != index_of_.end() &&
+           tree_of_[iu->second] == tree_of_[iv->second];
+  }
+
+  // Largest edge weight on the tree path u .. v. INT_MIN for u == v and
+  // INT_MAX if u and v are in different trees or not indexed.
+  int pathMax(Pointer u, Pointer v) const {
+    int child = -1;
+    return pathMaxChild(u, v, child);
+  }
+
+  // Like pathMax, and also reports a heaviest tree edge on the path in
+  // edge; edge is left untouched if the path is empty or missing.
+  int pathMax(Pointer u, Pointer v, Edge &edge) const {
+    int child = -1;
+    const int res = pathMaxChild(u, v, child);
+    if (child >= 0) {
+      edge = Edge(vertexs_[up_[child]], vertexs_[child], up_weight_[child]);
+    }
+    return res;
+  }
+
+  // the indexed forest
+  SpanningForest<T> forest() const {
+    SpanningForest<T> res;
+    for (const auto &e : tree_edges_) {
+      res.add(Edge(vertexs_[e.a], vertexs_[e.b], e.w));
+    }
+    return res;
+  }
+
+  void clear() {
+    vertexs_.clear();
+    index_of_.clear();
+    tree_edges_.clear();
+    weight_ = 0;
+    levels_ = 0;
+    up_.clear();
+    up_weight_.clear();
+    up_arg_.clear();
+    depth_.clear();
+    tree_of_.clear();
+  }
+
+private:
+  struct TreeEdge {
+    int a;
+    int b;
+    int w;
+  };
+
+  int idOf(Pointer data) {
+    auto it = index_of_.find(data);
+    if (it != index_of_.end()) {
+      return it->second;
+    }
+    const int id = static_cast<int>(vertexs_.size());
+    index_of_[data] = id;
+    vertexs_.push_back(data);
+    return id;
+  }
+
+  void addTreeEdge(const Edge &e) {
+    tree_edges_.push_back(
+        {idOf(e.from.get_data()), idOf(e.to.get_data()), e.weight_});
+    weight_ += e.weight_;
+  }
+
+  // Roots every tree at its first vertex with an iterative BFS, then fills
+  // level k of the tables from level k - 1. Level k of a vertex is stored
+  // at k * n + v; a root is its own ancestor with an INT_MIN edge.
+  void buildTables() {
+    const int n = static_cast<int>(vertexs_.size());
+    std::vector<int> offsets(n + 1, 0);
+    for (const auto &e : tree_edges_) {
+      ++offsets[e.a + 1];
+      ++offsets[e.b + 1];
+    }
+    for (int v = 0; v < n; ++v) {
+      offsets[v + 1] += offsets[v];
+    }
+    std::vector<std::pair<int, int>> adj(offsets[n]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto &e : tree_edges_) {
+      adj[fill[e.a]++] = {e.b, e.w};
+      adj[fill[e.b]++] = {e.a, e.w};
+    }
+
+    levels_ = 1;
+    while ((1 << levels_) < n) {
+      ++levels_;
+    }
+    up_.assign(static_cast<size_t>(levels_) * n, 0);
+    up_weight_.assign(static_cast<size_t>(levels_) * n, INT_MIN);
+    up_arg_.assign(static_cast<size_t>(levels_) * n, -1);
+    depth_.assign(n, -1);
+    tree_of_.assign(n, -1);
+    std::vector<int> queue;
+    queue.reserve(n);
+    for (int root = 0; root < n; ++root) {
+      if (depth_[root] >= 0) {
+        continue;
+      }
+      depth_[root] = 0;
+      tree_of_[root] = root;
+      up_[root] = root;
+      queue.clear();
+      queue.push_back(root);
+      for (size_t head = 0; head < queue.size(); ++head) {
+        const int u = queue[head];
+        for (int i = offsets[u]; i < offsets[u + 1]; ++i) {
+          const int v = adj[i].first;
+          if (depth_[v] >= 0) {
+            continue;
+          }
+          depth_[v] = depth_[u] + 1;
+          tree_of_[v] = root;
+          up_[v] = u;
+          up_weight_[v] = adj[i].second;
+          up_arg_[v] = v;
+          queue.push_back(v);
+        }
+      }
+    }
+    for (int k = 1; k < levels_; ++k) {
+      const size_t cur = static_cast<size_t>(k) * n;
+      const size_t prev = cur - n;
+      for (int v = 0; v < n; ++v) {
+        const int mid = up_[prev + v];
+        up_[cur + v] = up_[prev + mid];
+        if (up_weight_[prev + mid] > up_weight_[prev + v]) {
+          up_weight_[cur + v] = up_weight_[prev + mid];
+          up_arg_[cur + v] = up_arg_[prev + mid];
+        } else {
+          up_weight_[cur + v] = up_weight_[prev + v];
+          up_arg_[cur + v] = up_arg_[prev + v];
+        }
+      }
+    }
+  }
+
+  // up_[child] is the parent of child, so child names the tree edge
+  int pathMaxChild(Pointer u, Pointer v, int &child) const {
+    auto iu = index_of_.find(u);
+    auto iv = index_of_.find(v);
+    if (iu == index_of_.end() || iv == index_of_.end()) {
+      return INT_MAX;
+    }
+    int a = iu->second;
+    int b = iv->second;
+    if (tree_of_[a] != tree_of_[b]) {
+      return INT_MAX;
+    }
+    const size_t n = vertexs_.size();
+    int best = INT_MIN;
+    auto climb = [&](int &x, int k) {
+      const size_t at = static_cast<size_t>(k) * n + x;
+      if (up_weight_[at] > best) {
+        best = up_weight_[at];
+        child = up_arg_[at];
+      }
+      x = up_[at];
+    };
+    if (depth_[a] < depth_[b]) {
+      std::swap(a, b);
+    }
+    for (int k = levels_ - 1; k >= 0; --k) {
+      if (depth_[a] - (1 << k) >= depth_[b]) {
+        climb(a, k);
+      }
+    }
+    if (a == b) {
+      return best;
+    }
+    for (int k = levels_ - 1; k >= 0; --k) {
+      const size_t at = static_cast<size_t>(k) * n;
+      if (up_[at + a] != up_[at + b]) {
+        climb(a, k);
+        climb(b, k);
+      }
+    }
+    climb(a, 0);
+    climb(b, 0);
+    return best;
+  }
+
+  std::vector<Pointer> vertexs_;
+  std::unordered_map<Pointer, int> index_of_;
+  std::vector<TreeEdge> tree_edges_;
+  long long weight_ = 0;
+  int levels_ = 0;
+  // ancestor 2^k levels up, heaviest edge weight on the way and the child
+  // end of that edge
+  std::vector<int> up_;
+  std::vector<int> up_weight_;
+  std::vector<int> up_arg_;
+  std::vector<int> depth_;
+  // root of the tree each vertex is in
+  std::vector<int> tree_of_;
+};
+
+// Second-best minimum spanning forest: the lightest spanning forest other
+// than the one getMSTForest returns. It differs from the MST in a single
+// swap, a non-tree edge replacing the heaviest tree edge on its cycle, so
+// every non-tree edge is tried with one pathMax query. The weight may equal
+// the MST weight when weights tie. The result is empty if the graph has no
+// other spanning forest.
+template <typename T>
+SpanningForest<T> getSecondBestMSTForest(const Graph<T> *graph) {
+  if (graph == nullptr) {
+    std::cerr << "input graph is nullptr" << std::endl;
+    return {};
+  }
+  if (graph->isDirected()) {
+    std::cerr << "MST only applies to undirected graph" << std::endl;
+    return {};
+  }
+  MSTPathIndex<T> index(graph);
+  SpanningForest<T> mst = index.forest();
+  // every tree edge is skipped once among the graph edges, parallel
+  // copies of it are candidates like any other edge
+  CompactGraph<T> cg(graph);
+  std::unordered_map<std::uint64_t, size_t> tree_pos;
+  for (size_t i = 0; i < mst.edges.size(); ++i) {
+    int a = cg.indexOf(mst.edges[i].from.get_data());
+    int b = cg.indexOf(mst.edges[i].to.get_data());
+    if (a > b) {
+      std::swap(a, b);
+    }
+    tree_pos[(static_cast<std::uint64_t>(a) << 32) |
+             static_cast<std::uint32_t>(b)] = i;
+  }
+  std::vector<char> skipped(mst.edges.size(), 0);
+
+  long long best_delta = 0;
+  bool found = false;
+  typename Graph<T>::Edge best_in(nullptr, nullptr, 0);
+  typename Graph<T>::Edge best_out(nullptr, nullptr, 0);
+  for (int u = 0; u < static_cast<int>(cg.numVertexs()); ++u) {
+    for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+      const int v = cg.outTargets()[a];
+      const int w = cg.outWeights()[a];
+      if (v <= u) {
+        continue; // each edge once, self loops never help
+      }
+      auto it = tree_pos.find((static_cast<std::uint64_t>(u) << 32) |
+                              static_cast<std::uint32_t>(v));
+      if (it != tree_pos.end() && !skipped[it->second] &&
+          mst.edges[it->second].weight_ == w) {
+        skipped[it->second] = 1;
+        continue;
+      }
+      typename Graph<T>::Edge out(nullptr, nullptr, 0);
+      const int heaviest = index.pathMax(cg.vertexAt(u), cg.vertexAt(v), out);
+      const long long delta = static_cast<long long>(w) - heaviest;
+      if (!found || delta < best_delta) {
+        found = true;
+        best_delta = delta;
+        best_in = typename Graph<T>::Edge(cg.vertexAt(u), cg.vertexAt(v), w);
+        best_out = out;
+      }
+    }
+  }
+  if (!found) {
+    return {};
+  }
+  SpanningForest<T> res;
+  bool removed = false;
+  for (const auto &e : mst.edges) {
+    if (!removed && e.weight_ == best_out.weight_ &&
+        ((e.from.get_data() == best_out.from.get_data() &&
+          e.to.get_data() == best_out.to.get_data()) ||
+         (e.from.get_data() == best_out.to.get_data() &&
+          e.to.get_data() == best_out.from.get_data()))) {
+      removed = true;
+      continue;
+    }
+    res.add(e);
+  }
+  res.add(best_in);
+  return res;
+}
+
+} // namespace graphTest
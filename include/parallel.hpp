@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graphTest {
+
+// number of worker threads used when the caller passes 0
+inline size_t defaultThreadCount() {
+  const size_t n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+// Splits [0, n) into at most num_threads contiguous blocks and runs
+// fn(thread_id, begin, end) for each block on its own thread. The calling
+// thread runs block 0. Returns after every block is done.
+template <typename Fn>
+void parallelForBlocks(size_t n, size_t num_threads, Fn &&fn) {
+  if (num_threads == 0) {
+    num_threads = defaultThreadCount();
+  }
+  num_threads = std::max<size_t>(1, std::min(num_threads, n));
+  if (num_threads == 1) {
+    fn(size_t(0), size_t(0), n);
+    return;
+  }
+  const size_t chunk = (n + num_threads - 1) / num_threads;
+  std::vector<std::thread> workers;
+  workers.reserve(num_threads - 1);
+  for (size_t t = 1; t < num_threads; ++t) {
+    const size_t begin = std::min(n, t * chunk);
+    const size_t end = std::min(n, begin + chunk);
+    workers.emplace_back([&fn, t, begin, end]() { fn(t, begin, end); });
+  }
+  fn(size_t(0), size_t(0), std::min(n, chunk));
+  for (auto &w : workers) {
+    w.join();
+  }
+}
+
+// Keeps num_threads - 1 worker threads alive between parallel phases, for
+// algorithms that run many short phases where starting threads for every
+// phase (parallelForBlocks) costs more than the phase itself. forBlocks has
+// the contract of parallelForBlocks; calls must come from one thread.
+class ThreadTeam {
+public:
+  explicit ThreadTeam(size_t num_threads) {
+    if (num_threads == 0) {
+      num_threads = defaultThreadCount();
+    }
+    for (size_t t = 1; t < num_threads; ++t) {
+      workers_.emplace_back([this, t]() { work(t); });
+    }
+  }
+
+  ~ThreadTeam() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    start_.notify_all();
+    for (auto &w : workers_) {
+      w.join();
+    }
+  }
+
+  ThreadTeam(const ThreadTeam &) = delete;
+  ThreadTeam &operator=(const ThreadTeam &) = delete;
+
+  size_t size() const { return workers_.size() + 1; }
+
+  template <typename Fn> void forBlocks(size_t n, Fn &&fn) {
+    const size_t chunk = (n + size() - 1) / size();
+    if (workers_.empty() || chunk == n) {
+      fn(size_t(0), size_t(0), n);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = [&fn, n, chunk](size_t t) {
+        const size_t begin = std::min(n, t * chunk);
+        const size_t end = std::min(n, begin + chunk);
+        if (begin < end) {
+          fn(t, begin, end);
+        }
+      };
+      running_ = workers_.size();
+      ++generation_;
+    }
+    start_.notify_all();
+    fn(size_t(0), size_t(0), chunk);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return running_ == 0; });
+  }
+
+private:
+  void work(size_t t) {
+    size_t seen = 0;
+    while (true) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+      if (stop_) {
+        return;
+      }
+      seen = generation_;
+      lock.unlock();
+      job_(t);
+      lock.lock();
+      if (--running_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  std::function<void(size_t)> job_;
+  size_t generation_ = 0;
+  size_t running_ = 0;
+  bool stop_ = false;
+};
+
+} // namespace graphTest
@@ -0,0 +1,124 @@
+#pragma once
+#include "compact_graph.hpp"
+#include "graph.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace graphTest {
+
+// Reusable scratch memory for traversals that run many times on the same
+// graph. The workspace keeps a CompactGraph snapshot of the graph plus
+// per-vertex arrays indexed by dense vertex id. Per-vertex state is stamped
+// with an epoch, so newEpoch() "clears" every vertex in O(1).
+//
+// Functions taking a workspace call bind(g), which only rebuilds when a
+// different graph is passed. After modifying the bound graph call reset(g).
+template <typename DataT> class TraversalWorkspace {
+public:
+  typedef typename Graph<DataT>::Pointer Pointer;
+
+  TraversalWorkspace() = default;
+  explicit TraversalWorkspace(const Graph<DataT> *g) { reset(g); }
+
+  void reset(const Graph<DataT> *g) {
+    source_ = g;
+    graph_.build(g);
+    const size_t n = graph_.numVertexs();
+    stamp_.assign(n, 0);
+    state_.assign(n, 0);
+    value_.assign(n, 0);
+    low_.assign(n, 0);
+    cursor_.assign(n, 0);
+    epoch_ = 0;
+  }
+
+  void bind(const Graph<DataT> *g) {
+    if (g != source_) {
+      reset(g);
+    }
+  }
+
+  const Graph<DataT> *source() const { return source_; }
+  const CompactGraph<DataT> &graph() const { return graph_; }
+  size_t size() const { return graph_.numVertexs(); }
+
+  // forget every per-vertex state set so far
+  void newEpoch() {
+    if (++epoch_ == 0) {
+      std::fill(stamp_.begin(), stamp_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+  // 0 until setState() is called for v in the current epoch
+  int state(int v) const { return stamp_[v] == epoch_ ? state_[v] : 0; }
+  void setState(int v, int s) {
+    stamp_[v] = epoch_;
+    state_[v] = s;
+  }
+
+  // Unstamped per-vertex slots. They are only meaningful for vertices whose
+  // state() was set in the current epoch.
+  int &value(int v) { return value_[v]; }
+  int &low(int v) { return low_[v]; }
+  size_t &cursor(int v) { return cursor_[v]; }
+
+  // shared buffers, callers clear them before use
+  std::vector<int> &stack() { return stack_; }
+  std::vector<int> &queue() { return queue_; }
+  std::vector<int> &order() { return order_; }
+
+private:
+  const Graph<DataT> *source_ = nullptr;
+  CompactGraph<DataT> graph_;
+  std::vector<std::uint32_t> stamp_;
+  std::vector<int> state_;
+  std::vector<int> value_;
+  std::vector<int> low_;
+  std::vector<size_t> cursor_;
+  std::vector<int> stack_;
+  std::vector<int> queue_;
+  std::vector<int> order_;
+  std::uint32_t epoch_ = 0;
+};
+
+// Number of vertexs reachable from `start` following out-arcs and/or
+// in-arcs of the workspace graph (start included). Starts a new epoch and
+// leaves the reached vertexs with state 1.
+template <typename DataT>
+size_t countReachable(TraversalWorkspace<DataT> &ws, int start,
+                      bool follow_out, bool follow_in) {
+  const auto &cg = ws.graph();
+  std::vector<int> &stk = ws.stack();
+  stk.clear();
+  ws.newEpoch();
+  ws.setState(start, 1);
+  stk.push_back(start);
+  size_t count = 0;
+  auto visit = [&](int v) {
+    if (ws.state(v) == 0) {
+      ws.setState(v, 1);
+      stk.push_back(v);
+    }
+  };
+  while (!stk.empty()) {
+    const int u = stk.back();
+    stk.pop_back();
+    ++count;
+    if (follow_out) {
+      for (size_t a = cg.outBegin(u); a < cg.outEnd(u); ++a) {
+        visit(cg.outTargets()[a]);
+      }
+    }
+    if (follow_in) {
+      for (size_t a = cg.inBegin(u); a < cg.inEnd(u); ++a) {
+        visit(cg.inSources()[a]);
+      }
+    }
+  }
+  return count;
+}
+
+} // namespace graphTest
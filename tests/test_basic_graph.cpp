@@ -1,6 +1,7 @@
 // testing graph basic functions
 #include "basicAlgo.hpp"
 #include "graph.hpp"
+#include "parallel.hpp"
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -469,6 +470,136 @@ void test_reverse_undirected_graph() {
   assert(rev_g->getPrev(&data[0]).size() == 2);
 }
 
+void test_negative_weight_tracking() {
+  vector<int> data = {0, 1, 2};
+  gt::DirectedGraph<int> g;
+  g.addEdge(&data[0], &data[1], 3);
+  assert(!g.hasNegativeWeight());
+  g.addEdge(&data[1], &data[2], -2);
+  assert(g.hasNegativeWeight());
+  // overwriting the weight of an existing edge
+  g.addEdge(&data[1], &data[2], 4);
+  assert(!g.hasNegativeWeight());
+  g.addEdge(&data[2], &data[0], -1);
+  g.removeEdge(&data[2], &data[0]);
+  assert(!g.hasNegativeWeight());
+  g.addEdge(&data[0], &data[2], -5);
+  g.removeVertex(&data[2]);
+  assert(!g.hasNegativeWeight());
+
+  gt::UnDirectedGraph<int> ug;
+  ug.addEdge(&data[0], &data[1], -1);
+  assert(ug.hasNegativeWeight());
+  ug.removeEdge(&data[1], &data[0]);
+  assert(!ug.hasNegativeWeight());
+  ug.addEdge(&data[0], &data[1], -1);
+  ug.removeVertex(&data[0]);
+  assert(!ug.hasNegativeWeight());
+}
+
+void test_union_find() {
+  vector<int> data = {0, 1, 2, 3, 4, 5};
+  gt::UnionFind<int> uf;
+  for (auto &d : data) {
+    uf.add(&d);
+  }
+  uf.add(&data[0]); // duplicates are ignored
+  assert(uf.size() == 6);
+  assert(uf.numGroups() == 6);
+
+  assert(uf.merge(&data[0], &data[1]));
+  assert(uf.merge(&data[2], &data[1]));
+  assert(!uf.merge(&data[0], &data[2]));
+  assert(uf.merge(&data[4], &data[5]));
+  assert(!uf.merge(&data[0], nullptr));
+  assert(uf.numGroups() == 3);
+  assert(uf.same(&data[0], &data[2]));
+  assert(!uf.same(&data[0], &data[3]));
+  assert(uf.groupSize(&data[1]) == 3);
+  assert(uf.groupSize(&data[3]) == 1);
+  assert(uf.findParent(&data[2]) == uf.findParent(&data[0]));
+  int unknown = 9;
+  assert(uf.findParent(&unknown) == nullptr);
+
+  // groups come in order of their first added member
+  auto groups = uf.getGroups();
+  assert(groups.size() == 3);
+  assert((groups[0].second == vector<int *>{&data[0], &data[1], &data[2]}));
+  assert((groups[1].second == vector<int *>{&data[3]}));
+  assert((groups[2].second == vector<int *>{&data[4], &data[5]}));
+  assert(groups[0].first == uf.findParent(&data[0]));
+
+  // a long chain must not overflow the stack in find
+  const int n = 1000000;
+  gt::DisjointSets sets(n);
+  for (int i = 0; i + 1 < n; ++i) {
+    sets.merge(i, i + 1);
+  }
+  assert(sets.numSets() == 1);
+  assert(sets.setSize(n - 1) == n);
+  assert(sets.same(0, n - 1));
+}
+
+void test_concurrent_union_find() {
+  const int n = 20000;
+  std::vector<std::pair<int, int>> pairs;
+  unsigned seed = 7;
+  for (int i = 0; i < 15000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    const int a = (seed >> 8) % n;
+    seed = seed * 1103515245u + 12345u;
+    const int b = (seed >> 8) % n;
+    pairs.push_back({a, b});
+  }
+
+  gt::DisjointSets serial(n);
+  for (const auto &p : pairs) {
+    serial.merge(p.first, p.second);
+  }
+
+  gt::ConcurrentDisjointSets sets(n);
+  gt::parallelForBlocks(pairs.size(), 4, [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      sets.merge(pairs[i].first, pairs[i].second);
+      sets.find(pairs[i].second);
+    }
+  });
+  assert(sets.countSets() == serial.numSets());
+  for (int i = 0; i + 1 < n; ++i) {
+    assert(sets.same(i, i + 1) == serial.same(i, i + 1));
+  }
+  assert(!sets.merge(pairs[0].first, pairs[0].second));
+}
+
+void test_indexed_heap() {
+  const int n = 500;
+  gt::IndexedHeap<int> heap(n);
+  unsigned seed = 11;
+  std::vector<int> best(n, 1 << 30);
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    const int id = (seed >> 8) % n;
+    seed = seed * 1103515245u + 12345u;
+    const int key = (seed >> 8) % 1000;
+    const bool lowered = heap.pushOrDecrease(id, key);
+    assert(lowered == (key < best[id]));
+    best[id] = std::min(best[id], key);
+  }
+  // one entry per id, popped by key then id
+  assert(heap.size() <= static_cast<size_t>(n));
+  int last_key = -1, last_id = -1;
+  while (!heap.empty()) {
+    const int id = heap.top();
+    const int key = heap.key(id);
+    assert(key == best[id]);
+    assert(key > last_key || (key == last_key && id > last_id));
+    last_key = key;
+    last_id = id;
+    assert(heap.pop() == id);
+    assert(!heap.contains(id));
+  }
+}
+
 int main() {
 
   TEST_AND_RUN(test_directed_basic);
@@ -477,5 +608,9 @@ int main() {
   TEST_AND_RUN(test_undirected_adjacency);
   TEST_AND_RUN(test_reverse_directed_graph);
   TEST_AND_RUN(test_reverse_undirected_graph);
+  TEST_AND_RUN(test_negative_weight_tracking);
+  TEST_AND_RUN(test_union_find);
+  TEST_AND_RUN(test_concurrent_union_find);
+  TEST_AND_RUN(test_indexed_heap);
   return 0;
 }
\ No newline at end of file
@@ -62,9 +62,48 @@ void testBiconnectedEdgeComponent() {
     std::cout << "testBiconnectedEdgeComponent passed\n";
 }
 
+void testBiconnectedFlatResults() {
+    UnDirectedGraph<int> graph;
+    int n[6] = {0, 1, 2, 3, 4, 5};
+    // triangle 0-1-2, bridge 2-3, edge 3-4, isolated 5
+    graph.addEdge(&n[0], &n[1]);
+    graph.addEdge(&n[1], &n[2]);
+    graph.addEdge(&n[2], &n[0]);
+    graph.addEdge(&n[2], &n[3]);
+    graph.addEdge(&n[3], &n[4]);
+    graph.addVertex(&n[5]);
+
+    auto vbcc = getBiConnectedVertexCCMembers(&graph);
+    assert(vbcc.count() == 4);
+    // cut vertexs 2 and 3 appear twice
+    assert(vbcc.members.size() == 3 + 2 + 2 + 1);
+    assert(vbcc.toGroups().size() == 4);
+
+    auto ebcc = getBiConnectedEdgeCCLabels(&graph);
+    assert(ebcc.count == 4);
+    std::vector<int> label(6);
+    for (size_t i = 0; i < ebcc.vertexs.size(); ++i) {
+        label[*ebcc.vertexs[i]] = ebcc.label[i];
+    }
+    assert(label[0] == label[1] && label[1] == label[2]);
+    assert(label[3] != label[2] && label[4] != label[3]);
+    assert(label[5] != label[4]);
+    // the grouped result lists the same blocks in label order
+    auto groups = getBiConnectedEdgeCC(&graph);
+    assert(static_cast<int>(groups.size()) == ebcc.count);
+    for (size_t c = 0; c < groups.size(); ++c) {
+        for (int *v : groups[c]) {
+            assert(label[*v] == static_cast<int>(c));
+        }
+    }
+    assert(groups[label[0]].size() == 3);
+    std::cout << "testBiconnectedFlatResults passed\n";
+}
+
 int main() {
     testBiconnectedVertexComponent();
     testBiconnectedEdgeComponent();
+    testBiconnectedFlatResults();
     std::cout << "All biconnected component tests passed.\n";
     return 0;
 }
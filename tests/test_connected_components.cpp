@@ -0,0 +1,194 @@
+#include "graph.hpp"
+#include "graph_connected_component.hpp"
+#include "traversal_workspace.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace gt = graphTest;
+
+#define TEST_AND_RUN(test_name)                                                \
+  std::cout << "Running " << #test_name << "..." << std::endl;                 \
+  test_name();                                                                 \
+  std::cout << #test_name << " passed!" << std::endl;
+
+// two labelings describe the same partition
+void checkSamePartition(const std::vector<int> &a, const std::vector<int> &b) {
+  assert(a.size() == b.size());
+  std::vector<int> a_to_b(a.size(), -1);
+  std::vector<int> b_to_a(b.size(), -1);
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a_to_b[a[i]] == -1) {
+      a_to_b[a[i]] = b[i];
+    }
+    if (b_to_a[b[i]] == -1) {
+      b_to_a[b[i]] = a[i];
+    }
+    assert(a_to_b[a[i]] == b[i]);
+    assert(b_to_a[b[i]] == a[i]);
+  }
+}
+
+void test_connected_components_small() {
+  std::vector<int> data = {0, 1, 2, 3, 4, 5, 6};
+  /*
+  graph
+      0 -- 1 -- 2    3 -- 4    5    6 -- 6
+  */
+  gt::UnDirectedGraph<int> g;
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[1], &data[2]);
+  g.addEdge(&data[3], &data[4]);
+  g.addVertex(&data[5]);
+  g.addEdge(&data[6], &data[6]);
+
+  for (auto algo : {gt::UnionFindCC, gt::Afforest}) {
+    auto cc = gt::getConnectedComponents(&g, algo, 2);
+    assert(cc.count == 4);
+    assert(cc.vertexs.size() == 7);
+    auto groups = cc.toGroups();
+    std::vector<size_t> sizes;
+    for (auto &grp : groups) {
+      sizes.push_back(grp.size());
+    }
+    std::sort(sizes.begin(), sizes.end());
+    assert((sizes == std::vector<size_t>{1, 1, 2, 3}));
+
+    std::vector<int> offsets, members;
+    cc.getMembers(offsets, members);
+    assert(offsets.size() == 5 && offsets.back() == 7);
+    for (int c = 0; c < cc.count; ++c) {
+      for (int i = offsets[c]; i < offsets[c + 1]; ++i) {
+        assert(cc.label[members[i]] == c);
+      }
+    }
+    // labels are numbered by first vertex
+    assert(cc.label[0] == 0);
+  }
+
+  gt::DirectedGraph<int> dg;
+  dg.addEdge(&data[0], &data[1]);
+  assert(gt::getConnectedComponents(&dg).count == 0);
+}
+
+void test_connected_components_random() {
+  // a giant component plus many small pieces
+  const int n = 20000;
+  std::vector<int> data(n);
+  gt::UnDirectedGraph<int> g;
+  std::mt19937 rng(11);
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  std::uniform_int_distribution<int> giant(0, n / 2 - 1);
+  for (int i = 0; i < n; ++i) {
+    g.addEdge(&data[giant(rng)], &data[giant(rng)]);
+  }
+  for (int i = n / 2; i + 1 < n; i += 3) {
+    g.addEdge(&data[i], &data[i + 1]);
+  }
+
+  auto serial = gt::getConnectedComponents(&g, gt::UnionFindCC);
+  for (size_t threads : {1, 4}) {
+    auto parallel = gt::getConnectedComponents(&g, gt::Afforest, threads);
+    assert(parallel.count == serial.count);
+    checkSamePartition(serial.label, parallel.label);
+  }
+}
+
+void test_weakly_connected_components() {
+  std::vector<int> data = {0, 1, 2, 3, 4, 5};
+  /*
+  graph
+      0 --> 1 <-- 2    3 --> 4 --> 3    5
+  */
+  gt::DirectedGraph<int> g;
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[2], &data[1]);
+  g.addEdge(&data[3], &data[4]);
+  g.addEdge(&data[4], &data[3]);
+  g.addVertex(&data[5]);
+
+  for (auto algo : {gt::UnionFindCC, gt::Afforest}) {
+    auto wcc = gt::getWeaklyConnectedComponents(&g, algo, 2);
+    assert(wcc.count == 3);
+    std::vector<int> label(6);
+    for (size_t i = 0; i < wcc.vertexs.size(); ++i) {
+      label[*wcc.vertexs[i]] = wcc.label[i];
+    }
+    assert(label[0] == label[1] && label[1] == label[2]);
+    assert(label[3] == label[4]);
+    assert(label[0] != label[3] && label[5] != label[0] &&
+           label[5] != label[3]);
+  }
+
+  // a giant chain whose vertexs also point at leaves; a leaf is linked by
+  // the third out-arc of its chain vertex, or by its own in-arc when the
+  // chain vertex is skipped as part of the giant component
+  const int n = 3000;
+  std::vector<int> chain(n), leaf(n);
+  gt::DirectedGraph<int> star;
+  for (int i = 0; i < n; ++i) {
+    chain[i] = i;
+    leaf[i] = n + i;
+  }
+  for (int i = 0; i + 2 < n; ++i) {
+    star.addEdge(&chain[i], &chain[i + 1]);
+    star.addEdge(&chain[i], &chain[i + 2]);
+    star.addEdge(&chain[i], &leaf[i]);
+  }
+  int lone = -1;
+  star.addVertex(&lone);
+  auto serial = gt::getWeaklyConnectedComponents(&star, gt::UnionFindCC);
+  auto parallel = gt::getWeaklyConnectedComponents(&star, gt::Afforest, 4);
+  assert(serial.count == 2 && parallel.count == 2);
+  checkSamePartition(serial.label, parallel.label);
+}
+
+void test_is_weakly_connected() {
+  // a directed chain with a stray arc pointing into it from one end, plus
+  // one isolated vertex
+  const int n = 5000;
+  std::vector<int> data(n + 1);
+  gt::DirectedGraph<int> g;
+  for (int i = 0; i <= n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  for (int i = 0; i + 1 < n; ++i) {
+    if (i % 2 == 0) {
+      g.addEdge(&data[i], &data[i + 1]);
+    } else {
+      g.addEdge(&data[i + 1], &data[i]);
+    }
+  }
+  gt::TraversalWorkspace<int> ws(&g);
+  for (size_t threads : {0, 1, 4}) {
+    assert(gt::isWeaklyConnected(ws, true, threads));
+    assert(!gt::isWeaklyConnected(ws, false, threads));
+  }
+
+  // splitting the chain disconnects it either way
+  g.removeEdge(&data[n / 2 + 1], &data[n / 2]);
+  g.removeEdge(&data[n / 2], &data[n / 2 + 1]);
+  ws.reset(&g);
+  for (size_t threads : {0, 1, 4}) {
+    assert(!gt::isWeaklyConnected(ws, true, threads));
+    assert(!gt::isWeaklyConnected(ws, false, threads));
+  }
+
+  gt::DirectedGraph<int> empty;
+  gt::TraversalWorkspace<int> ews(&empty);
+  assert(!gt::isWeaklyConnected(ews, false));
+}
+
+int main() {
+  TEST_AND_RUN(test_connected_components_small);
+  TEST_AND_RUN(test_connected_components_random);
+  TEST_AND_RUN(test_weakly_connected_components);
+  TEST_AND_RUN(test_is_weakly_connected);
+  return 0;
+}
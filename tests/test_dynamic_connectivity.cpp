@@ -0,0 +1,132 @@
+#include "dynamic_connectivity.hpp"
+#include "graph.hpp"
+#include "graph_connected_component.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace gt = graphTest;
+
+#define TEST_AND_RUN(test_name)                                                \
+  std::cout << "Running " << #test_name << "..." << std::endl;                 \
+  test_name();                                                                 \
+  std::cout << #test_name << " passed!" << std::endl;
+
+void test_dynamic_connectivity_basic() {
+  std::vector<int> data = {0, 1, 2, 3, 4};
+  /*
+  graph
+      0 -- 1 -- 2 -- 0    3 -- 4
+  */
+  gt::DynamicUnDirectedGraph<int> g;
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[1], &data[2]);
+  g.addEdge(&data[2], &data[0]);
+  g.addEdge(&data[3], &data[4]);
+  assert(g.connected(&data[0], &data[2]));
+  assert(!g.connected(&data[0], &data[3]));
+  assert(g.numComponents() == 2);
+  assert(g.componentSize(&data[1]) == 3);
+
+  // the cycle keeps 0 and 1 connected through 2
+  g.removeEdge(&data[0], &data[1]);
+  assert(g.connected(&data[0], &data[1]));
+  g.removeEdge(&data[2], &data[1]);
+  assert(!g.connected(&data[0], &data[1]));
+  assert(g.connected(&data[0], &data[2]));
+  assert(g.numComponents() == 3);
+
+  g.addEdge(&data[1], &data[3]);
+  assert(g.connected(&data[1], &data[4]));
+  g.removeVertex(&data[3]);
+  assert(!g.connected(&data[1], &data[4]));
+  assert(!g.connected(&data[3], &data[3]));
+  assert(g.numComponents() == 3);
+
+  int lone = 9;
+  g.addVertex(&lone);
+  assert(g.connected(&lone, &lone));
+  assert(!g.connected(&lone, &data[0]));
+  assert(g.componentSize(&lone) == 1);
+  assert(g.numComponents() == 4);
+}
+
+void test_dynamic_connectivity_random() {
+  // random insertions and deletions checked against a full recomputation
+  const int n = 60;
+  std::vector<int> data(n);
+  gt::DynamicUnDirectedGraph<int> g;
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  std::vector<std::pair<int, int>> present;
+  for (int step = 0; step < 4000; ++step) {
+    if (present.empty() || rng() % 5 < 3) {
+      const int a = pick(rng), b = pick(rng);
+      if (a != b && g.getNext(&data[a]).size() < 6) {
+        bool known = false;
+        for (auto &p : present) {
+          known = known || (p == std::make_pair(a, b)) ||
+                  (p == std::make_pair(b, a));
+        }
+        if (!known) {
+          present.push_back({a, b});
+        }
+        g.addEdge(&data[a], &data[b]);
+      }
+    } else {
+      const size_t k = rng() % present.size();
+      g.removeEdge(&data[present[k].first], &data[present[k].second]);
+      present[k] = present.back();
+      present.pop_back();
+    }
+
+    if (step % 20 == 0) {
+      auto cc = gt::getConnectedComponents<int>(&g);
+      std::vector<int> label(n);
+      for (size_t i = 0; i < cc.vertexs.size(); ++i) {
+        label[*cc.vertexs[i]] = cc.label[i];
+      }
+      assert(g.numComponents() == static_cast<size_t>(cc.count));
+      for (int q = 0; q < 50; ++q) {
+        const int a = pick(rng), b = pick(rng);
+        assert(g.connected(&data[a], &data[b]) == (label[a] == label[b]));
+      }
+    }
+  }
+}
+
+void test_dynamic_connectivity_long_path() {
+  // cutting a long path in the middle and joining it again
+  const int n = 20000;
+  gt::DynamicConnectivity dc;
+  for (int i = 0; i < n; ++i) {
+    dc.addVertex();
+  }
+  for (int i = 0; i + 1 < n; ++i) {
+    assert(dc.insertEdge(i, i + 1));
+  }
+  assert(!dc.insertEdge(5, 6));
+  assert(dc.numComponents() == 1);
+  assert(dc.insertEdge(0, n - 1)); // closes a cycle, non-tree edge
+  for (int i = 0; i + 1 < n; i += 1000) {
+    assert(dc.removeEdge(i, i + 1));
+  }
+  assert(!dc.removeEdge(0, 1));
+  assert(dc.numComponents() == 20);
+  assert(dc.connected(0, n - 1));
+  assert(!dc.connected(0, 1));
+  assert(dc.componentSize(1) == 1000);
+}
+
+int main() {
+  TEST_AND_RUN(test_dynamic_connectivity_basic);
+  TEST_AND_RUN(test_dynamic_connectivity_random);
+  TEST_AND_RUN(test_dynamic_connectivity_long_path);
+  return 0;
+}
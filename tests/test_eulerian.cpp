@@ -100,6 +100,26 @@ void testZeroDegreeOnlyGraphs() {
   std::cout << "testZeroDegreeOnlyGraphs passed\n";
 }
 
+void testEulerianWithWorkspace() {
+  UnDirectedGraph<int> graph;
+  int n1 = 1, n2 = 2, n3 = 3, n4 = 4;
+
+  graph.addEdge(&n1, &n2);
+  graph.addEdge(&n2, &n3);
+  graph.addVertex(&n4);
+
+  TraversalWorkspace<int> ws(&graph);
+  for (int round = 0; round < 3; ++round) {
+    assert(isEulerian(&graph, ws) == false);
+    assert(isSemiEulerian(&graph, ws) == true);
+  }
+  graph.addEdge(&n3, &n1);
+  ws.reset(&graph);
+  assert(isEulerian(&graph, ws) == true);
+  assert(isSemiEulerian(&graph, ws) == false);
+  std::cout << "testEulerianWithWorkspace passed\n";
+}
+
 int main() {
   testUndirectedEulerian();
   testUndirectedSemiEulerian();
@@ -108,6 +128,7 @@ int main() {
   testDirectedSemiEulerian();
   testDirectedNonEulerian();
   testZeroDegreeOnlyGraphs();
+  testEulerianWithWorkspace();
   std::cout << "All eulerian tests passed.\n";
   return 0;
 }
@@ -126,11 +126,39 @@ void testIsBipartiteUndirected() {
   assert(gt::isBipartite(&g) == false);
 }
 
+void testCheckWithWorkspace() {
+  gt::UnDirectedGraph<std::string> g;
+  std::string data[] = {"A", "B", "C", "D"};
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[1], &data[2]);
+  g.addEdge(&data[2], &data[3]);
+
+  gt::TraversalWorkspace<std::string> ws(&g);
+  for (int round = 0; round < 3; ++round) {
+    assert(gt::hasCircle(&g, ws) == false);
+    assert(gt::isBipartite(&g, ws) == true);
+  }
+  g.addEdge(&data[3], &data[1]); // odd cycle B-C-D
+  ws.reset(&g);
+  assert(gt::hasCircle(&g, ws) == true);
+  assert(gt::isBipartite(&g, ws) == false);
+
+  // binding another graph rebuilds the workspace
+  gt::DirectedGraph<std::string> dg;
+  dg.addEdge(&data[0], &data[1]);
+  dg.addEdge(&data[1], &data[2]);
+  assert(gt::hasCircle(&dg, ws) == false);
+  dg.addEdge(&data[2], &data[0]);
+  ws.reset(&dg);
+  assert(gt::hasCircle(&dg, ws) == true);
+}
+
 int main() {
   TEST_AND_RUN(test_directedGraph_circle);
   TEST_AND_RUN(test_undirectedGraph_circle);
   TEST_AND_RUN(test_directedGraph_same);
   TEST_AND_RUN(testIsBipartiteDirected);
   TEST_AND_RUN(testIsBipartiteUndirected);
+  TEST_AND_RUN(testCheckWithWorkspace);
   std::cout << "All tests passed!" << std::endl;
 }
\ No newline at end of file
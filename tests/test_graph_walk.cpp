@@ -1,5 +1,6 @@
 #include "graph.hpp"
 #include "graph_walk.hpp"
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <string>
@@ -161,10 +162,169 @@ void test_UndirectGraph_BFS_walk() {
                                                       "B", "F", "A"};
   assert(expected_BFS_post_order == visit_order);
 }
+void test_walk_with_workspace() {
+  gt::DirectedGraph<std::string> g;
+  std::string data[] = {"A", "B", "C", "D", "E", "F", "G"};
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[0], &data[2]);
+  g.addEdge(&data[1], &data[3]);
+  g.addEdge(&data[2], &data[4]);
+  g.addEdge(&data[4], &data[3]);
+  g.addEdge(&data[5], &data[6]);
+
+  std::function<std::vector<std::string *>(std::string *)> getNexts =
+      [&g](std::string *v) { return g.getNext(v); };
+  std::vector<std::string *> pre, post, ws_pre, ws_post;
+  std::function<void(std::string *)> onPre = [&](std::string *v) {
+    pre.push_back(v);
+  };
+  std::function<void(std::string *)> onPost = [&](std::string *v) {
+    post.push_back(v);
+  };
+  std::function<void(std::string *)> onWsPre = [&](std::string *v) {
+    ws_pre.push_back(v);
+  };
+  std::function<void(std::string *)> onWsPost = [&](std::string *v) {
+    ws_post.push_back(v);
+  };
+
+  gt::TraversalWorkspace<std::string> ws(&g);
+  std::vector<std::string *> starts = {&data[0], &data[5]};
+  // reuse the same workspace several times, results must not leak
+  for (int round = 0; round < 3; ++round) {
+    pre.clear();
+    post.clear();
+    ws_pre.clear();
+    ws_post.clear();
+    auto order = gt::DFS<std::string>(starts, getNexts, onPre, onPost);
+    auto ws_order =
+        gt::DFS<std::string>(starts, getNexts, ws, onWsPre, onWsPost);
+    assert(order == ws_order);
+    assert(pre == ws_pre);
+    assert(post == ws_post);
+
+    pre.clear();
+    post.clear();
+    ws_pre.clear();
+    ws_post.clear();
+    order = gt::BFS<std::string>(starts, getNexts, onPre, onPost);
+    ws_order = gt::BFS<std::string>(starts, getNexts, ws, onWsPre, onWsPost);
+    assert(order == ws_order);
+    assert(pre == ws_pre);
+    assert(post == ws_post);
+  }
+}
+
+void test_lazy_walk() {
+  gt::DirectedGraph<std::string> g;
+  std::string data[] = {"A", "B", "C", "D", "E", "F", "G"};
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[0], &data[2]);
+  g.addEdge(&data[1], &data[3]);
+  g.addEdge(&data[2], &data[4]);
+  g.addEdge(&data[4], &data[3]);
+  g.addEdge(&data[5], &data[6]);
+
+  // lazy walks yield exactly what Walk passes to its walker
+  for (auto algo : {gt::WalkAlgo::BFS_PREORDER, gt::WalkAlgo::BFS_POSTORDER,
+                    gt::WalkAlgo::DFS_PREORDER, gt::WalkAlgo::DFS_POSTORDER}) {
+    for (bool reverse : {false, true}) {
+      std::vector<std::string *> eager;
+      std::function<void(std::string *)> func = [&eager](std::string *v) {
+        eager.push_back(v);
+      };
+      gt::Walk(algo, &g, reverse, func);
+      std::vector<std::string *> lazy;
+      for (auto *v : gt::WalkLazy(algo, &g, reverse)) {
+        lazy.push_back(v);
+      }
+      assert(eager == lazy);
+    }
+  }
+
+  // take a prefix and stop
+  std::vector<std::string> prefix;
+  for (auto *v : gt::WalkLazy(gt::WalkAlgo::DFS_PREORDER, &g, false)) {
+    prefix.push_back(*v);
+    if (prefix.size() == 3) {
+      break;
+    }
+  }
+  std::vector<std::string> expected_prefix = {"A", "B", "D"};
+  assert(prefix == expected_prefix);
+
+  // interleave two traversals with the pull interface
+  auto from_a = gt::WalkLazy(gt::WalkAlgo::BFS_PREORDER, &g, false,
+                             {&data[0]});
+  auto from_f = gt::WalkLazy(gt::WalkAlgo::BFS_PREORDER, &g, false,
+                             {&data[5]});
+  std::vector<std::string> mixed;
+  bool more_a = true, more_f = true;
+  while (more_a || more_f) {
+    if (more_a && (more_a = from_a.next())) {
+      mixed.push_back(*from_a.value());
+    }
+    if (more_f && (more_f = from_f.next())) {
+      mixed.push_back(*from_f.value());
+    }
+  }
+  std::vector<std::string> expected_mixed = {"A", "F", "B", "G", "C", "D",
+                                             "E"};
+  assert(mixed == expected_mixed);
+}
+
+void test_lazy_walk_edges() {
+  gt::UnDirectedGraph<int> g;
+  int data[] = {0, 1, 2, 3, 4, 5};
+  g.addEdge(&data[0], &data[1], 1);
+  g.addEdge(&data[0], &data[2], 2);
+  g.addEdge(&data[1], &data[3], 3);
+  g.addEdge(&data[2], &data[3], 4);
+  g.addEdge(&data[3], &data[4], 5);
+  g.addVertex(&data[5]);
+
+  for (auto algo : {gt::WalkAlgo::BFS_PREORDER, gt::WalkAlgo::DFS_PREORDER}) {
+    std::vector<int *> preorder;
+    for (auto *v : gt::WalkLazy(algo, &g, false, {&data[0]})) {
+      preorder.push_back(v);
+    }
+    // tree edges discover every reachable vertex but the start exactly once
+    std::vector<int *> discovered = {&data[0]};
+    int weight = 0;
+    for (const auto &e : gt::WalkEdgesLazy(algo, &g, false, {&data[0]})) {
+      assert(std::find(discovered.begin(), discovered.end(),
+                       e.from.get_data()) != discovered.end());
+      discovered.push_back(e.to.get_data());
+      weight += e.weight_;
+    }
+    assert(discovered.size() == 5);
+    if (algo == gt::WalkAlgo::DFS_PREORDER) {
+      assert(discovered == preorder);
+    }
+    assert(weight > 0);
+  }
+
+  gt::DirectedGraph<int> dg;
+  dg.addEdge(&data[0], &data[1], 7);
+  dg.addEdge(&data[1], &data[2], 8);
+  std::vector<int> weights;
+  for (const auto &e :
+       gt::WalkEdgesLazy(gt::WalkAlgo::DFS_PREORDER, &dg, true, {&data[2]})) {
+    // reverse walk keeps the graph direction of the edges
+    assert(dg.getOutdegrees(e.from.get_data()) == 1);
+    weights.push_back(e.weight_);
+  }
+  std::vector<int> expected_weights = {8, 7};
+  assert(weights == expected_weights);
+}
+
 int main() {
   TEST_AND_RUN(test_DirectGraph_DFS_walk);
   TEST_AND_RUN(test_DirectGraph_BFS_walk);
   TEST_AND_RUN(test_UndirectGraph_DFS_walk);
   TEST_AND_RUN(test_UndirectGraph_BFS_walk);
+  TEST_AND_RUN(test_walk_with_workspace);
+  TEST_AND_RUN(test_lazy_walk);
+  TEST_AND_RUN(test_lazy_walk_edges);
   std::cout << "All tests passed!" << std::endl;
 }
\ No newline at end of file
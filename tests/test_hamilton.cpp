@@ -98,6 +98,26 @@ void testZeroDegreeOnlyGraphs() {
   std::cout << "testZeroDegreeOnlyGraphs passed\n";
 }
 
+void testHamiltonianWithWorkspace() {
+  DirectedGraph<int> graph;
+  int n1 = 1, n2 = 2, n3 = 3, n4 = 4;
+
+  graph.addEdge(&n1, &n2);
+  graph.addEdge(&n2, &n3);
+  graph.addEdge(&n3, &n4);
+
+  TraversalWorkspace<int> ws(&graph);
+  for (int round = 0; round < 3; ++round) {
+    assert(isHamiltonian(&graph, ws) == false);
+    assert(isSemiHamiltonian(&graph, ws) == true);
+  }
+  graph.addEdge(&n4, &n1);
+  ws.reset(&graph);
+  assert(isHamiltonian(&graph, ws) == true);
+  assert(isSemiHamiltonian(&graph, ws) == false);
+  std::cout << "testHamiltonianWithWorkspace passed\n";
+}
+
 int main() {
   testUndirectedHamiltonian();
   testUndirectedSemiHamiltonian();
@@ -106,6 +126,7 @@ int main() {
   testDirectedSemiHamiltonian();
   testDirectedNonSemiHamiltonian();
   testZeroDegreeOnlyGraphs();
+  testHamiltonianWithWorkspace();
   std::cout << "All hamilton tests passed.\n";
   return 0;
 }
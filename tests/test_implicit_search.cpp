@@ -0,0 +1,206 @@
+#include "implicit_search.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gt = graphTest;
+
+#define TEST_AND_RUN(test_name)                                                \
+  std::cout << "Running " << #test_name << "..." << std::endl;                 \
+  test_name();                                                                 \
+  std::cout << #test_name << " passed!" << std::endl;
+
+// 4-connected grid, '#' is a wall. A state is row * width + col.
+struct GridWorld {
+  std::vector<std::string> rows;
+  int width() const { return static_cast<int>(rows[0].size()); }
+  int height() const { return static_cast<int>(rows.size()); }
+
+  gt::SearchProblem<int> problem(int start, int goal) const {
+    gt::SearchProblem<int> p;
+    p.start = start;
+    p.isGoal = [goal](const int &s) { return s == goal; };
+    p.successors = [this](const int &s, std::vector<std::pair<int, int>> &out) {
+      const int r = s / width(), c = s % width();
+      const int dr[] = {1, -1, 0, 0};
+      const int dc[] = {0, 0, 1, -1};
+      for (int k = 0; k < 4; ++k) {
+        const int nr = r + dr[k], nc = c + dc[k];
+        if (nr >= 0 && nr < height() && nc >= 0 && nc < width() &&
+            rows[nr][nc] != '#') {
+          out.push_back({nr * width() + nc, 1});
+        }
+      }
+    };
+    const int w = width();
+    p.heuristic = [goal, w](const int &s) -> long long {
+      return std::abs(s / w - goal / w) + std::abs(s % w - goal % w);
+    };
+    return p;
+  }
+
+  // plain BFS distance as reference
+  long long bfs(int start, int goal) const {
+    auto p = problem(start, goal);
+    std::unordered_map<int, long long> dist = {{start, 0}};
+    std::queue<int> q;
+    q.push(start);
+    std::vector<std::pair<int, int>> nexts;
+    while (!q.empty()) {
+      const int s = q.front();
+      q.pop();
+      if (s == goal) {
+        return dist[s];
+      }
+      nexts.clear();
+      p.successors(s, nexts);
+      for (auto &n : nexts) {
+        if (dist.count(n.first) == 0) {
+          dist[n.first] = dist[s] + 1;
+          q.push(n.first);
+        }
+      }
+    }
+    return -1;
+  }
+};
+
+GridWorld makeMaze() {
+  return GridWorld{{
+      "..........",
+      ".########.",
+      ".#......#.",
+      ".#.####.#.",
+      ".#.#..#.#.",
+      ".#.#.##.#.",
+      ".#.#....#.",
+      ".#.######.",
+      ".#........",
+      "...#######",
+  }};
+}
+
+void checkGridPath(const GridWorld &w, const gt::SearchResult<int> &res,
+                   int start, int goal) {
+  assert(res.found);
+  assert(res.path.front() == start);
+  assert(res.path.back() == goal);
+  assert(static_cast<long long>(res.path.size()) == res.cost + 1);
+  for (size_t i = 0; i + 1 < res.path.size(); ++i) {
+    const int a = res.path[i], b = res.path[i + 1];
+    assert(std::abs(a / w.width() - b / w.width()) +
+               std::abs(a % w.width() - b % w.width()) ==
+           1);
+    assert(w.rows[b / w.width()][b % w.width()] != '#');
+  }
+}
+
+void test_astar_and_idastar_optimal() {
+  GridWorld w = makeMaze();
+  const int start = 0;
+  const int goal = 4 * w.width() + 4; // inside the spiral
+  const long long expected = w.bfs(start, goal);
+  assert(expected > 0);
+
+  auto p = w.problem(start, goal);
+  auto astar = gt::ImplicitSearch(p, gt::ImplicitSearchAlgo::A_STAR);
+  checkGridPath(w, astar, start, goal);
+  assert(astar.cost == expected);
+
+  auto ida = gt::ImplicitSearch(p, gt::ImplicitSearchAlgo::IDA_STAR);
+  checkGridPath(w, ida, start, goal);
+  assert(ida.cost == expected);
+
+  // without heuristic A* degrades to Dijkstra and stays optimal
+  p.heuristic = nullptr;
+  auto dijkstra = gt::ImplicitSearch(p, gt::ImplicitSearchAlgo::A_STAR);
+  assert(dijkstra.cost == expected);
+  assert(dijkstra.expanded >= astar.expanded);
+}
+
+void test_beam_search() {
+  GridWorld w = makeMaze();
+  const int start = 0;
+  const int goal = 4 * w.width() + 4;
+  auto p = w.problem(start, goal);
+
+  gt::ImplicitSearchOptions opt;
+  opt.beam_width = 1000; // wider than any layer: plain BFS, optimal
+  auto wide = gt::ImplicitSearch(p, gt::ImplicitSearchAlgo::BEAM, opt);
+  checkGridPath(w, wide, start, goal);
+  assert(wide.cost == w.bfs(start, goal));
+
+  // the corridor is one cell wide, a beam of 2 still reaches the goal
+  opt.beam_width = 2;
+  auto narrow = gt::ImplicitSearch(p, gt::ImplicitSearchAlgo::BEAM, opt);
+  checkGridPath(w, narrow, start, goal);
+
+  // open 100x100 grid: each layer generates about three times the beam, only
+  // the survivors of the cut are stored
+  GridWorld open{std::vector<std::string>(100, std::string(100, '.'))};
+  const int far = open.width() * open.height() - 1;
+  opt.beam_width = 8;
+  auto beam = gt::ImplicitSearch(open.problem(0, far),
+                                 gt::ImplicitSearchAlgo::BEAM, opt);
+  checkGridPath(open, beam, 0, far);
+  const size_t depth = beam.path.size() - 1;
+  assert(beam.stored <= 1 + depth * opt.beam_width + 1);
+  assert(beam.stored * 2 < beam.generated);
+}
+
+void test_unreachable_and_limits() {
+  GridWorld w{{
+      "..#..",
+      "..#..",
+      "..#..",
+  }};
+  auto p = w.problem(0, 4);
+  for (auto algo :
+       {gt::ImplicitSearchAlgo::A_STAR, gt::ImplicitSearchAlgo::IDA_STAR,
+        gt::ImplicitSearchAlgo::BEAM}) {
+    auto res = gt::ImplicitSearch(p, algo);
+    assert(!res.found);
+    assert(res.path.empty());
+  }
+
+  GridWorld maze = makeMaze();
+  auto mp = maze.problem(0, 4 * maze.width() + 4);
+  gt::ImplicitSearchOptions opt;
+  opt.max_expansions = 5;
+  auto cut = gt::ImplicitSearch(mp, gt::ImplicitSearchAlgo::A_STAR, opt);
+  assert(!cut.found);
+  assert(cut.expanded == 5);
+}
+
+void test_unbounded_space() {
+  // states are all positive integers: x -> x + 1 (cost 1), x -> 2x (cost 1)
+  // the space is infinite, so it can not be stored in a Graph
+  gt::SearchProblem<long long> p;
+  p.start = 1;
+  const long long target = 100000;
+  p.isGoal = [target](const long long &s) { return s == target; };
+  p.successors = [target](const long long &s,
+                          std::vector<std::pair<long long, int>> &out) {
+    out.push_back({s + 1, 1});
+    if (s * 2 <= target) {
+      out.push_back({s * 2, 1});
+    }
+  };
+  // 100000 = 0b11000011010100000: 16 doublings + 5 increments
+  auto res = gt::ImplicitSearch(p, gt::ImplicitSearchAlgo::A_STAR);
+  assert(res.found);
+  assert(res.cost == 21);
+  assert(res.path.front() == 1 && res.path.back() == target);
+}
+
+int main() {
+  TEST_AND_RUN(test_astar_and_idastar_optimal);
+  TEST_AND_RUN(test_beam_search);
+  TEST_AND_RUN(test_unreachable_and_limits);
+  TEST_AND_RUN(test_unbounded_space);
+  return 0;
+}
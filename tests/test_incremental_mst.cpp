@@ -0,0 +1,123 @@
+#include "graph.hpp"
+#include "graph_mst.hpp"
+#include "incremental_mst.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace gt = graphTest;
+
+#define TEST_AND_RUN(test_name)                                                \
+  std::cout << "Running " << #test_name << "..." << std::endl;                 \
+  test_name();                                                                 \
+  std::cout << #test_name << " passed!" << std::endl;
+
+void test_incremental_mst_basic() {
+  std::vector<int> data = {0, 1, 2, 3, 4};
+  /*
+  graph
+      0 --4-- 1 --5-- 2    3 --1-- 4
+  */
+  gt::UnDirectedGraph<int> g;
+  g.addEdge(&data[0], &data[1], 4);
+  g.addEdge(&data[1], &data[2], 5);
+  g.addEdge(&data[3], &data[4], 1);
+  gt::IncrementalMST<int> mst(&g);
+  assert(mst.weight() == 10);
+  assert(mst.numTrees() == 2);
+  assert(!mst.connected(&data[0], &data[3]));
+
+  // joins the two trees
+  assert(mst.insertEdge(&data[2], &data[3], 7));
+  assert(mst.weight() == 17);
+  assert(mst.numTrees() == 1);
+  assert(mst.connected(&data[0], &data[4]));
+
+  // closes the cycle 0-1-2-3 and replaces the heaviest edge 2-3
+  assert(mst.insertEdge(&data[0], &data[3], 2));
+  assert(mst.weight() == 12);
+  // too heavy for the cycle 0-1-2
+  assert(!mst.insertEdge(&data[0], &data[2], 6));
+  assert(mst.weight() == 12);
+
+  // a tree edge gets cheaper in place
+  assert(mst.decreaseWeight(&data[1], &data[2], 3));
+  assert(mst.weight() == 10);
+  // the dropped edge 0-2 became cheaper than 0-1 (4)
+  assert(mst.decreaseWeight(&data[0], &data[2], 1));
+  assert(mst.weight() == 7);
+  assert(mst.numTreeEdges() == 4);
+
+  auto forest = mst.forest();
+  assert(forest.edges.size() == 4);
+  assert(forest.weight == 7);
+}
+
+void test_incremental_mst_random() {
+  // after every insertion the weight matches a fresh Kruskal run
+  const int n = 60;
+  std::vector<int> data(n);
+  gt::UnDirectedGraph<int> g;
+  gt::IncrementalMST<int> mst;
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+    mst.addVertex(&data[i]);
+  }
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  std::uniform_int_distribution<int> weight(-20, 100);
+  for (int step = 0; step < 600; ++step) {
+    const int u = pick(rng), v = pick(rng);
+    if (u == v) {
+      continue;
+    }
+    const int w = weight(rng);
+    // keep a single copy per pair at its lowest weight
+    std::vector<gt::Graph<int>::Edge> edges;
+    g.getOutEdges(&data[u], edges);
+    int old = w;
+    for (const auto &e : edges) {
+      if (e.to.get_data() == &data[v]) {
+        old = e.weight_;
+      }
+    }
+    if (old < w) {
+      continue;
+    }
+    g.removeEdge(&data[u], &data[v]);
+    g.addEdge(&data[u], &data[v], w);
+    mst.insertEdge(&data[u], &data[v], w);
+    auto expected = gt::getMSTForest<int>(&g);
+    assert(mst.weight() == expected.weight);
+    assert(mst.numTreeEdges() == expected.edges.size());
+  }
+}
+
+void test_incremental_mst_long_path() {
+  // a path of 100000 vertexs, then one chord per vertex that is lighter
+  // than the path edge it spans
+  const int n = 100000;
+  std::vector<int> data(n);
+  gt::IncrementalMST<int> mst;
+  long long total = 0;
+  for (int i = 0; i + 1 < n; ++i) {
+    mst.insertEdge(&data[i], &data[i + 1], 1000);
+    total += 1000;
+  }
+  assert(mst.weight() == total);
+  for (int i = 0; i + 2 < n; i += 2) {
+    assert(mst.insertEdge(&data[i], &data[i + 2], 10));
+    total -= 990;
+  }
+  assert(mst.weight() == total);
+  assert(mst.numTrees() == 1);
+}
+
+int main() {
+  TEST_AND_RUN(test_incremental_mst_basic);
+  TEST_AND_RUN(test_incremental_mst_random);
+  TEST_AND_RUN(test_incremental_mst_long_path);
+  return 0;
+}
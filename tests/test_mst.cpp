@@ -1,7 +1,9 @@
 
 #include "graph_mst.hpp"
 #include <cassert>
+#include <climits>
 #include <iostream>
+#include <random>
 using namespace std;
 namespace gt = graphTest;
 
@@ -214,10 +216,210 @@ void  test_dmst_tarjan() {
   }
   assert(total_weight2 == 8);
 }
+void test_spanning_forest_edges() {
+  vector<std::string> data = {"A", "B", "C", "D", "E", "F", "G", "H"};
+  gt::UnDirectedGraph<std::string> ug;
+  ug.addEdge(&data[0], &data[1], 2);
+  ug.addEdge(&data[0], &data[2], 3);
+  ug.addEdge(&data[1], &data[2], 1);
+  ug.addEdge(&data[1], &data[3], 4);
+  ug.addEdge(&data[2], &data[3], 5);
+  ug.addEdge(&data[2], &data[4], 6);
+  ug.addEdge(&data[3], &data[4], 7);
+  ug.addEdge(&data[5], &data[6], 8);
+  ug.addVertex(&data[7]);
+  for (auto algo : {gt::KRUSKAL, gt::PRIM, gt::BORUVKA, gt::BORUVKA_KRUSKAL,
+                    gt::FILTER_KRUSKAL}) {
+    auto forest = gt::getMSTForest<std::string>(&ug, algo);
+    assert(forest.edges.size() == 5);
+    assert(forest.weight == 21);
+  }
+  // PRIM makes the isolated vertex a tree of its own, KRUSKAL leaves it out
+  assert(gt::getMSTs<std::string>(&ug, gt::PRIM).size() == 3);
+  assert(gt::getMSTs<std::string>(&ug, gt::KRUSKAL).size() == 2);
+
+  gt::DirectedGraph<std::string> dg;
+  dg.addEdge(&data[0], &data[1], 2);
+  dg.addEdge(&data[0], &data[2], 3);
+  dg.addEdge(&data[1], &data[2], 1);
+  dg.addEdge(&data[1], &data[3], 4);
+  dg.addEdge(&data[2], &data[3], 5);
+  dg.addEdge(&data[2], &data[4], 6);
+  dg.addEdge(&data[3], &data[4], 7);
+  dg.addEdge(&data[5], &data[6], 8);
+  for (auto algo : {gt::ZHULIU, gt::TARJAN, gt::GABOW}) {
+    auto forest = gt::getDMSTForest<std::string>(&dg, algo);
+    assert(forest.edges.size() == 5);
+    assert(forest.weight == 21);
+  }
+  assert(gt::getMSTForest<std::string>(&dg).edges.empty());
+}
+
+void test_mst_boruvka_matches_kruskal() {
+  // random sparse graph with many equal weights and a few components
+  const int n = 2000;
+  vector<int> data(n);
+  gt::UnDirectedGraph<int> g;
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  std::uniform_int_distribution<int> weight(-5, 20);
+  for (int i = 0; i < 3 * n; ++i) {
+    const int u = pick(rng), v = pick(rng);
+    if (u != v && u % 10 != 0 && v % 10 != 0) {
+      g.addEdge(&data[u], &data[v], weight(rng));
+    }
+  }
+  auto expected = gt::getMSTForest<int>(&g, gt::KRUSKAL);
+  assert(gt::getMSTForest<int>(&g, gt::PRIM).weight == expected.weight);
+  for (auto algo : {gt::BORUVKA, gt::BORUVKA_KRUSKAL}) {
+    for (size_t threads : {1, 4}) {
+      auto forest = gt::getMSTForest<int>(&g, algo, threads);
+      assert(forest.weight == expected.weight);
+      assert(forest.edges.size() == expected.edges.size());
+      for (size_t i = 0; i < forest.edges.size(); ++i) {
+        assert(forest.edges[i].from.get_data() ==
+               expected.edges[i].from.get_data());
+        assert(forest.edges[i].to.get_data() ==
+               expected.edges[i].to.get_data());
+      }
+    }
+  }
+}
+
+void test_mst_filter_kruskal() {
+  // enough edges for several partition levels above the base case: one
+  // weight for every edge (keys differ only in the edge index), few
+  // distinct weights, and a wide range
+  const int n = 5000;
+  vector<int> data(n);
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+  }
+  for (int max_weight : {0, 3, 1000000}) {
+    gt::UnDirectedGraph<int> g;
+    for (int i = 0; i < n; ++i) {
+      g.addVertex(&data[i]);
+    }
+    std::mt19937 rng(11 + max_weight);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::uniform_int_distribution<int> weight(-max_weight, max_weight);
+    for (int i = 0; i < 4 * n; ++i) {
+      const int u = pick(rng), v = pick(rng);
+      if (u != v && u % 7 != 0 && v % 7 != 0) {
+        g.addEdge(&data[u], &data[v], weight(rng));
+      }
+    }
+    auto expected = gt::getMSTForest<int>(&g, gt::KRUSKAL);
+    auto forest = gt::getMSTForest<int>(&g, gt::FILTER_KRUSKAL);
+    assert(forest.weight == expected.weight);
+    assert(forest.edges.size() == expected.edges.size());
+    for (size_t i = 0; i < forest.edges.size(); ++i) {
+      assert(forest.edges[i].from.get_data() ==
+             expected.edges[i].from.get_data());
+      assert(forest.edges[i].to.get_data() ==
+             expected.edges[i].to.get_data());
+    }
+  }
+}
+
+void test_prim_dense_and_sparse() {
+  // complete graph: Prim uses the O(V^2) scan
+  const int n = 60;
+  vector<int> data(n);
+  gt::UnDirectedGraph<int> dense, sparse;
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    dense.addVertex(&data[i]);
+    sparse.addVertex(&data[i]);
+  }
+  for (int i = 0; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      dense.addEdge(&data[i], &data[j], (i * 7 + j * 13) % 17);
+    }
+    if (i + 1 < n && i % 15 != 14) {
+      sparse.addEdge(&data[i], &data[i + 1], (i * 5) % 7);
+    }
+    if (i + 3 < n) {
+      sparse.addEdge(&data[i], &data[i + 3], (i * 3) % 11);
+    }
+  }
+  for (auto *g : {&dense, &sparse}) {
+    auto prim = gt::getMSTForest<int>(g, gt::PRIM);
+    auto kruskal = gt::getMSTForest<int>(g, gt::KRUSKAL);
+    assert(prim.weight == kruskal.weight);
+    assert(prim.edges.size() == kruskal.edges.size());
+    assert(gt::getMSTs<int>(g, gt::PRIM).size() ==
+           gt::getMSTs<int>(g, gt::KRUSKAL).size());
+  }
+}
+
+void test_dmst_gabow() {
+  // random digraphs without parallel arcs, compared against Zhu-Liu
+  std::mt19937 rng(3);
+  for (int round = 0; round < 30; ++round) {
+    const int n = 2 + round;
+    vector<int> data(n);
+    gt::DirectedGraph<int> g;
+    for (int i = 0; i < n; ++i) {
+      data[i] = i;
+      g.addVertex(&data[i]);
+    }
+    std::uniform_int_distribution<int> weight(-3, 9);
+    std::bernoulli_distribution has_arc(0.15);
+    std::vector<std::vector<int>> arc_weight(n, std::vector<int>(n, INT_MAX));
+    for (int u = 0; u < n; ++u) {
+      for (int v = 0; v < n; ++v) {
+        if (u != v && has_arc(rng)) {
+          arc_weight[u][v] = weight(rng);
+          g.addEdge(&data[u], &data[v], arc_weight[u][v]);
+        }
+      }
+    }
+    auto expected = gt::getDMSTForest<int>(&g, gt::ZHULIU);
+    auto forest = gt::getDMSTForest<int>(&g, gt::GABOW);
+    assert(forest.weight == expected.weight);
+    assert(forest.edges.size() == expected.edges.size());
+    // every vertex has at most one parent and the trees are acyclic
+    auto trees = gt::getDMSTs<int>(&g, gt::GABOW);
+    assert(trees.size() == static_cast<size_t>(n) - forest.edges.size());
+    std::vector<int> in_degree(n, 0);
+    for (const auto &e : forest.edges) {
+      assert(arc_weight[*e.from.get_data()][*e.to.get_data()] == e.weight_);
+      ++in_degree[*e.to.get_data()];
+    }
+    for (int d : in_degree) {
+      assert(d <= 1);
+    }
+  }
+
+  // one long directed cycle: a single contraction of 100000 vertexs
+  const int n = 100000;
+  vector<int> data(n);
+  gt::DirectedGraph<int> ring;
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+  }
+  for (int i = 0; i < n; ++i) {
+    ring.addEdge(&data[i], &data[(i + 1) % n], i == 500 ? 10 : 1);
+  }
+  auto forest = gt::getDMSTForest<int>(&ring, gt::GABOW);
+  assert(forest.edges.size() == static_cast<size_t>(n - 1));
+  assert(forest.weight == n - 1);
+}
+
 int main() {
   TEST_AND_RUN(test_mst_kruskal);
   TEST_AND_RUN(test_mst_prim);
   TEST_AND_RUN(test_dmst_zhuliu);
   TEST_AND_RUN(test_dmst_tarjan);
+  TEST_AND_RUN(test_dmst_gabow);
+  TEST_AND_RUN(test_spanning_forest_edges);
+  TEST_AND_RUN(test_mst_boruvka_matches_kruskal);
+  TEST_AND_RUN(test_mst_filter_kruskal);
+  TEST_AND_RUN(test_prim_dense_and_sparse);
   return 0;
 }
\ No newline at end of file
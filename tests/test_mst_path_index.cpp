@@ -0,0 +1,188 @@
+#include "graph.hpp"
+#include "graph_mst.hpp"
+#include "mst_path_index.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace gt = graphTest;
+
+#define TEST_AND_RUN(test_name)                                                \
+  std::cout << "Running " << #test_name << "..." << std::endl;                 \
+  test_name();                                                                 \
+  std::cout << #test_name << " passed!" << std::endl;
+
+// largest edge weight on the minimax path, by trying thresholds
+int bottleneck(const std::vector<std::vector<std::pair<int, int>>> &adj, int s,
+               int t) {
+  for (int limit = -100; limit <= 100; ++limit) {
+    std::vector<char> seen(adj.size(), 0);
+    std::vector<int> stack = {s};
+    seen[s] = 1;
+    while (!stack.empty()) {
+      const int u = stack.back();
+      stack.pop_back();
+      for (const auto &p : adj[u]) {
+        if (p.second <= limit && !seen[p.first]) {
+          seen[p.first] = 1;
+          stack.push_back(p.first);
+        }
+      }
+    }
+    if (seen[t]) {
+      return limit;
+    }
+  }
+  return INT_MAX;
+}
+
+void test_mst_path_max() {
+  std::vector<int> data = {0, 1, 2, 3, 4, 5, 6};
+  /*
+  graph
+      0 --2-- 1 --1-- 2
+      0 --3-- 2
+      1 --4-- 3 --5-- 2
+      2 --6-- 4 --7-- 3
+      5 --8-- 6
+  */
+  gt::UnDirectedGraph<int> g;
+  g.addEdge(&data[0], &data[1], 2);
+  g.addEdge(&data[0], &data[2], 3);
+  g.addEdge(&data[1], &data[2], 1);
+  g.addEdge(&data[1], &data[3], 4);
+  g.addEdge(&data[2], &data[3], 5);
+  g.addEdge(&data[2], &data[4], 6);
+  g.addEdge(&data[3], &data[4], 7);
+  g.addEdge(&data[5], &data[6], 8);
+  gt::MSTPathIndex<int> index(&g);
+  assert(index.weight() == 21);
+  assert(index.pathMax(&data[0], &data[2]) == 2);
+  assert(index.pathMax(&data[3], &data[4]) == 6);
+  assert(index.pathMax(&data[0], &data[0]) == INT_MIN);
+  assert(index.pathMax(&data[0], &data[5]) == INT_MAX);
+  assert(index.pathMax(&data[5], &data[6]) == 8);
+  assert(!index.connected(&data[4], &data[6]));
+
+  gt::Graph<int>::Edge heaviest(nullptr, nullptr, 0);
+  assert(index.pathMax(&data[0], &data[4], heaviest) == 6);
+  assert(heaviest.weight_ == 6);
+
+  // the same index built from getMSTs output
+  auto trees = gt::getMSTs<int>(&g);
+  gt::MSTPathIndex<int> from_trees(trees);
+  for (int u = 0; u < 7; ++u) {
+    for (int v = 0; v < 7; ++v) {
+      assert(from_trees.pathMax(&data[u], &data[v]) ==
+             index.pathMax(&data[u], &data[v]));
+    }
+  }
+}
+
+void test_mst_path_max_random() {
+  const int n = 300;
+  std::vector<int> data(n);
+  gt::UnDirectedGraph<int> g;
+  std::vector<std::vector<std::pair<int, int>>> adj(n);
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  std::mt19937 rng(9);
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  std::uniform_int_distribution<int> weight(-50, 50);
+  // addEdge overwrites the weight of an existing pair, keep the first
+  std::set<std::pair<int, int>> used;
+  for (int i = 0; i < 2 * n; ++i) {
+    const int u = pick(rng), v = pick(rng);
+    if (u == v || !used.insert({std::min(u, v), std::max(u, v)}).second) {
+      continue;
+    }
+    const int w = weight(rng);
+    g.addEdge(&data[u], &data[v], w);
+    adj[u].push_back({v, w});
+    adj[v].push_back({u, w});
+  }
+  gt::MSTPathIndex<int> index(&g);
+  for (int q = 0; q < 200; ++q) {
+    const int u = pick(rng), v = pick(rng);
+    if (u == v) {
+      continue;
+    }
+    assert(index.pathMax(&data[u], &data[v]) == bottleneck(adj, u, v));
+  }
+}
+
+void test_second_best_mst() {
+  std::vector<int> data = {0, 1, 2, 3};
+  /*
+  graph
+      0 --1-- 1 --2-- 2 --3-- 3
+      0 --5-- 2    1 --4-- 3
+  */
+  gt::UnDirectedGraph<int> g;
+  g.addEdge(&data[0], &data[1], 1);
+  g.addEdge(&data[1], &data[2], 2);
+  g.addEdge(&data[2], &data[3], 3);
+  g.addEdge(&data[0], &data[2], 5);
+  g.addEdge(&data[1], &data[3], 4);
+  auto mst = gt::getMSTForest<int>(&g);
+  assert(mst.weight == 6);
+  // 1-3 replaces 2-3: 6 - 3 + 4
+  auto second = gt::getSecondBestMSTForest<int>(&g);
+  assert(second.weight == 7);
+  assert(second.edges.size() == 3);
+
+  // a tree has no other spanning tree
+  gt::UnDirectedGraph<int> path;
+  path.addEdge(&data[0], &data[1], 1);
+  path.addEdge(&data[1], &data[2], 1);
+  assert(gt::getSecondBestMSTForest<int>(&path).edges.empty());
+
+  // brute force over all spanning trees of a small random graph
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> weight(0, 6);
+  std::vector<int> vs = {0, 1, 2, 3, 4};
+  gt::UnDirectedGraph<int> k5;
+  std::vector<std::pair<std::pair<int, int>, int>> edges;
+  for (int u = 0; u < 5; ++u) {
+    for (int v = u + 1; v < 5; ++v) {
+      const int w = weight(rng);
+      k5.addEdge(&vs[u], &vs[v], w);
+      edges.push_back({{u, v}, w});
+    }
+  }
+  std::vector<long long> totals;
+  for (unsigned mask = 0; mask < (1u << edges.size()); ++mask) {
+    if (std::popcount(mask) != 4) {
+      continue;
+    }
+    gt::DisjointSets sets(5);
+    long long total = 0;
+    bool tree = true;
+    for (size_t i = 0; i < edges.size(); ++i) {
+      if (mask >> i & 1) {
+        tree = tree && sets.merge(edges[i].first.first, edges[i].first.second);
+        total += edges[i].second;
+      }
+    }
+    if (tree) {
+      totals.push_back(total);
+    }
+  }
+  std::sort(totals.begin(), totals.end());
+  assert(gt::getMSTForest<int>(&k5).weight == totals[0]);
+  assert(gt::getSecondBestMSTForest<int>(&k5).weight == totals[1]);
+}
+
+int main() {
+  TEST_AND_RUN(test_mst_path_max);
+  TEST_AND_RUN(test_mst_path_max_random);
+  TEST_AND_RUN(test_second_best_mst);
+  return 0;
+}
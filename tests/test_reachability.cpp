@@ -0,0 +1,207 @@
+#include "graph.hpp"
+#include "graph_reachability.hpp"
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gt = graphTest;
+
+#define TEST_AND_RUN(test_name)                                                \
+  std::cout << "Running " << #test_name << "..." << std::endl;                 \
+  test_name();                                                                 \
+  std::cout << #test_name << " passed!" << std::endl;
+
+void test_directed_hop_distance() {
+  std::vector<std::string> data = {"A", "B", "C", "D", "E", "F", "G"};
+  /*
+  graph
+      A --> B --> C --> D
+      A --> E --> D
+      F --> G
+  */
+  gt::DirectedGraph<std::string> g;
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[1], &data[2]);
+  g.addEdge(&data[2], &data[3]);
+  g.addEdge(&data[0], &data[4]);
+  g.addEdge(&data[4], &data[3]);
+  g.addEdge(&data[5], &data[6]);
+
+  assert(gt::hopDistance(&g, &data[0], &data[0]) == 0);
+  assert(gt::hopDistance(&g, &data[0], &data[1]) == 1);
+  assert(gt::hopDistance(&g, &data[0], &data[3]) == 2);
+  assert(gt::hopDistance(&g, &data[1], &data[3]) == 2);
+  assert(gt::hopDistance(&g, &data[3], &data[0]) == -1);
+  assert(gt::hopDistance(&g, &data[0], &data[6]) == -1);
+
+  assert(gt::isReachable(&g, &data[0], &data[3]));
+  assert(gt::isReachable(&g, &data[5], &data[6]));
+  assert(!gt::isReachable(&g, &data[6], &data[5]));
+  assert(!gt::isReachable(&g, &data[2], &data[4]));
+
+  std::string outsider = "X";
+  assert(!gt::isReachable(&g, &data[0], &outsider));
+  assert(gt::hopDistance(&g, &outsider, &data[0]) == -1);
+}
+
+void test_undirected_hop_distance() {
+  std::vector<int> data = {0, 1, 2, 3, 4, 5};
+  // ring 0-1-2-3-4-5-0
+  gt::UnDirectedGraph<int> g;
+  for (int i = 0; i < 6; ++i) {
+    g.addEdge(&data[i], &data[(i + 1) % 6]);
+  }
+  assert(gt::hopDistance(&g, &data[0], &data[3]) == 3);
+  assert(gt::hopDistance(&g, &data[0], &data[4]) == 2);
+  assert(gt::hopDistance(&g, &data[5], &data[1]) == 2);
+  assert(gt::isReachable(&g, &data[3], &data[0]));
+}
+
+void test_batch_reachability() {
+  const int n = 50;
+  std::vector<int> data(n);
+  gt::DirectedGraph<int> g;
+  // two chains 0..24 and 25..49 with shortcuts every 5 vertices
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  for (int i = 0; i + 1 < n; ++i) {
+    if (i == 24) {
+      continue;
+    }
+    g.addEdge(&data[i], &data[i + 1]);
+    if (i % 5 == 0 && i + 5 < n && (i < 25) == (i + 5 < 25)) {
+      g.addEdge(&data[i], &data[i + 5]);
+    }
+  }
+
+  gt::BatchReachability<int> batch(&g);
+  std::vector<std::pair<int *, int *>> queries;
+  for (int s = 0; s < n; ++s) {
+    for (int t = 0; t < n; ++t) {
+      queries.push_back({&data[s], &data[t]});
+    }
+  }
+  auto hops = batch.hopDistance(queries);
+  auto reach = batch.isReachable(queries);
+  assert(hops.size() == queries.size());
+  for (size_t i = 0; i < queries.size(); ++i) {
+    [[maybe_unused]] int expected =
+        gt::hopDistance(&g, queries[i].first, queries[i].second);
+    assert(hops[i] == expected);
+    assert(reach[i] == (expected >= 0));
+  }
+  assert(batch.hopDistance(&data[0], &data[24]) == 8);
+  assert(batch.hopDistance(&data[0], &data[25]) == -1);
+}
+
+void test_reachability_index() {
+  const int n = 120;
+  std::vector<int> data(n);
+  gt::DirectedGraph<int> g;
+  std::mt19937 rng(42);
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  // mostly forward edges plus a few back edges that create SCCs
+  for (int k = 0; k < 3 * n; ++k) {
+    int u = rng() % n;
+    int v = rng() % n;
+    if (u == v) {
+      continue;
+    }
+    if (u > v && rng() % 8 != 0) {
+      std::swap(u, v);
+    }
+    g.addEdge(&data[u], &data[v]);
+  }
+
+  gt::ReachabilityIndex<int> index(&g, 3);
+  assert(index.numVertexs() == static_cast<size_t>(n));
+  for (int s = 0; s < n; ++s) {
+    for (int t = 0; t < n; ++t) {
+      assert(index.reaches(&data[s], &data[t]) ==
+             gt::isReachable(&g, &data[s], &data[t]));
+    }
+  }
+
+  // round trip through the text format
+  std::stringstream ss;
+  index.save(ss);
+  gt::ReachabilityIndex<int> loaded;
+  assert(loaded.load(ss, index.vertexs()));
+  assert(loaded.numComponents() == index.numComponents());
+  for (int s = 0; s < n; ++s) {
+    for (int t = 0; t < n; ++t) {
+      assert(loaded.reaches(&data[s], &data[t]) ==
+             index.reaches(&data[s], &data[t]));
+    }
+  }
+
+  std::stringstream broken("not-an-index 1 2 3");
+  assert(!loaded.load(broken, index.vertexs()));
+  assert(loaded.empty());
+
+  // header counts beyond the vertex count, and indexes out of range
+  std::stringstream huge("graphTest-reachability-v1 120 120 1 999999999999");
+  assert(!loaded.load(huge, index.vertexs()));
+  assert(loaded.empty());
+  // lines: header, comp_of, dag_offsets, dag_targets, ...
+  auto corrupt = [&](size_t line, const std::string &value) {
+    std::stringstream in(ss.str());
+    std::stringstream out;
+    std::string text;
+    for (size_t i = 0; std::getline(in, text); ++i) {
+      if (i == line) {
+        const size_t end = text.find(' ');
+        text = value + (end == std::string::npos ? "" : text.substr(end));
+      }
+      out << text << '\n';
+    }
+    return out;
+  };
+  const std::string comps = std::to_string(index.numComponents());
+  for (auto bad : {std::make_pair(size_t(1), comps),
+                   std::make_pair(size_t(1), std::string("-1")),
+                   std::make_pair(size_t(2), std::string("1")),
+                   std::make_pair(size_t(3), comps)}) {
+    std::stringstream in = corrupt(bad.first, bad.second);
+    assert(!loaded.load(in, index.vertexs()));
+    assert(loaded.empty());
+  }
+}
+
+void test_reachability_index_cycle() {
+  std::vector<std::string> data = {"A", "B", "C", "D"};
+  // A -> B -> C -> A, C -> D
+  gt::DirectedGraph<std::string> g;
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[1], &data[2]);
+  g.addEdge(&data[2], &data[0]);
+  g.addEdge(&data[2], &data[3]);
+  gt::ReachabilityIndex<std::string> index(&g);
+  assert(index.numComponents() == 2);
+  assert(index.reaches(&data[1], &data[0]));
+  assert(index.reaches(&data[0], &data[3]));
+  assert(!index.reaches(&data[3], &data[0]));
+
+  gt::UnDirectedGraph<std::string> ug;
+  ug.addEdge(&data[0], &data[1]);
+  gt::ReachabilityIndex<std::string> undirected(&ug);
+  assert(undirected.empty());
+}
+
+int main() {
+  TEST_AND_RUN(test_directed_hop_distance);
+  TEST_AND_RUN(test_undirected_hop_distance);
+  TEST_AND_RUN(test_batch_reachability);
+  TEST_AND_RUN(test_reachability_index);
+  TEST_AND_RUN(test_reachability_index_cycle);
+  return 0;
+}
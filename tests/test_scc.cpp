@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <random>
 
 using namespace graphTest;
 
@@ -54,8 +55,130 @@ void test_scc() {
     std::cout << "SCC tests passed successfully!" << std::endl;
 }
 
+void test_scc_workspace() {
+    DirectedGraph<int> graph;
+    int data[6] = {0, 1, 2, 3, 4, 5};
+    // 0 <-> 1, 1 -> 2 -> 3 -> 2, 3 -> 4, 5 isolated
+    graph.addEdge(&data[0], &data[1]);
+    graph.addEdge(&data[1], &data[0]);
+    graph.addEdge(&data[1], &data[2]);
+    graph.addEdge(&data[2], &data[3]);
+    graph.addEdge(&data[3], &data[2]);
+    graph.addEdge(&data[3], &data[4]);
+    graph.addVertex(&data[5]);
+
+    TraversalWorkspace<int> ws(&graph);
+    std::vector<std::vector<int*>> expected = {
+        {&data[0], &data[1]}, {&data[2], &data[3]}, {&data[4]}, {&data[5]}};
+    normalizeSCC(expected);
+    for (int round = 0; round < 3; ++round) {
+        auto tarjan = getSCC(&graph, Tarjan, ws);
+        auto kosaraju = getSCC(&graph, Kosaraju, ws);
+        normalizeSCC(tarjan);
+        normalizeSCC(kosaraju);
+        assert(tarjan == expected);
+        assert(kosaraju == expected);
+    }
+
+    // random graph against mutual reachability from plain BFS on the graph
+    const int n = 200;
+    std::vector<int> rdata(n);
+    DirectedGraph<int> random_graph;
+    for (int i = 0; i < n; ++i) {
+        rdata[i] = i;
+        random_graph.addVertex(&rdata[i]);
+    }
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    for (int i = 0; i < 260; ++i) {
+        random_graph.addEdge(&rdata[pick(rng)], &rdata[pick(rng)]);
+    }
+    std::vector<std::vector<char>> reach(n, std::vector<char>(n, 0));
+    std::vector<Graph<int>::Edge> out;
+    for (int s = 0; s < n; ++s) {
+        std::vector<int> queue = {s};
+        reach[s][s] = 1;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            random_graph.getOutEdges(&rdata[queue[head]], out);
+            for (const auto& e : out) {
+                const int v = *e.to.get_data();
+                if (!reach[s][v]) {
+                    reach[s][v] = 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+    std::vector<std::vector<int*>> brute;
+    std::vector<char> placed(n, 0);
+    for (int u = 0; u < n; ++u) {
+        if (placed[u]) {
+            continue;
+        }
+        brute.emplace_back();
+        for (int v = u; v < n; ++v) {
+            if (reach[u][v] && reach[v][u]) {
+                placed[v] = 1;
+                brute.back().push_back(&rdata[v]);
+            }
+        }
+    }
+    normalizeSCC(brute);
+    TraversalWorkspace<int> rws(&random_graph);
+    for (auto algo : {Tarjan, Kosaraju}) {
+        auto scc = getSCC(&random_graph, algo, rws);
+        normalizeSCC(scc);
+        assert(scc == brute);
+    }
+
+    // a long chain must not overflow the call stack
+    std::vector<int> chain(200000);
+    DirectedGraph<int> path;
+    for (size_t i = 0; i + 1 < chain.size(); ++i) {
+        path.addEdge(&chain[i], &chain[i + 1]);
+    }
+    assert(getSCC(&path, Tarjan).size() == chain.size());
+    assert(getSCC(&path, Kosaraju).size() == chain.size());
+    std::cout << "SCC workspace tests passed successfully!" << std::endl;
+}
+
+void test_scc_labels() {
+    DirectedGraph<int> graph;
+    int data[5] = {0, 1, 2, 3, 4};
+    // 0 -> 1 -> 2 -> 0, 2 -> 3 -> 4
+    graph.addEdge(&data[0], &data[1]);
+    graph.addEdge(&data[1], &data[2]);
+    graph.addEdge(&data[2], &data[0]);
+    graph.addEdge(&data[2], &data[3]);
+    graph.addEdge(&data[3], &data[4]);
+
+    for (auto algo : {Tarjan, Kosaraju}) {
+        auto scc = getSCCLabels(&graph, algo);
+        assert(scc.count == 3);
+        std::vector<int> label(5);
+        for (size_t i = 0; i < scc.vertexs.size(); ++i) {
+            label[*scc.vertexs[i]] = scc.label[i];
+        }
+        assert(label[0] == label[1] && label[1] == label[2]);
+        assert(label[3] != label[0] && label[4] != label[3]);
+        if (algo == Tarjan) {
+            // reverse topological: 4 first, then 3, then the cycle
+            assert(label[4] == 0 && label[3] == 1 && label[0] == 2);
+        } else {
+            assert(label[0] == 0 && label[3] == 1 && label[4] == 2);
+        }
+        std::vector<int> offsets, members;
+        scc.getMembers(offsets, members);
+        assert((offsets == std::vector<int>{0, offsets[1], offsets[2], 5}));
+        assert(offsets[label[0] + 1] - offsets[label[0]] == 3);
+    }
+    std::cout << "SCC label tests passed successfully!" << std::endl;
+}
+
 int main() {
     std::cout << "Running SCC tests..." << std::endl;
     test_scc();
+    test_scc_workspace();
+    test_scc_labels();
     return 0;
 }
@@ -1,6 +1,10 @@
 #include "graph_shartest_path.hpp"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <random>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -20,6 +24,49 @@ int totalWeight(const std::vector<typename gt::Graph<T>::Edge>& edges) {
     return sum;
 }
 
+// distance of every vertex reached by a shortest path tree
+template <typename T>
+std::unordered_map<T *, long long>
+treeDistances(const std::vector<typename gt::Graph<T>::Edge> &edges,
+              T *source) {
+  std::unordered_map<T *, typename gt::Graph<T>::Edge> parent;
+  for (const auto &e : edges) {
+    assert(parent.count(e.to.get_data()) == 0);
+    parent.insert({e.to.get_data(), e});
+  }
+  std::unordered_map<T *, long long> dist;
+  dist[source] = 0;
+  for (const auto &e : edges) {
+    std::vector<T *> chain;
+    T *v = e.to.get_data();
+    while (dist.count(v) == 0) {
+      chain.push_back(v);
+      v = parent.at(v).from.get_data();
+    }
+    for (size_t i = chain.size(); i-- > 0;) {
+      const auto &pe = parent.at(chain[i]);
+      dist[chain[i]] = dist.at(pe.from.get_data()) + pe.weight_;
+    }
+  }
+  return dist;
+}
+
+// random digraph with weights in [0, max_weight]
+void randomGraph(gt::DirectedGraph<int> &g, std::vector<int> &data, int n,
+                 int m, int max_weight, unsigned seed) {
+  data.resize(n);
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  std::uniform_int_distribution<int> weight(0, max_weight);
+  for (int i = 0; i < m; ++i) {
+    g.addEdge(&data[pick(rng)], &data[pick(rng)], weight(rng));
+  }
+}
+
 void test_dijkstra() {
   vector<std::string> data = {"S", "A", "B", "C", "D"};
   // S:0, A:1, B:2, C:3, D:4
@@ -93,6 +140,364 @@ void test_floyd_warshall() {
 }
 
 
+void test_dijkstra_radix() {
+  vector<std::string> data = {"S", "A", "B", "C", "D"};
+  gt::DirectedGraph<std::string> g;
+  g.addEdge(&data[0], &data[1], 10);
+  g.addEdge(&data[0], &data[3], 5);
+  g.addEdge(&data[1], &data[2], 1);
+  g.addEdge(&data[1], &data[3], 2);
+  g.addEdge(&data[3], &data[1], 3);
+  g.addEdge(&data[3], &data[2], 9);
+  g.addEdge(&data[3], &data[4], 2);
+  g.addEdge(&data[4], &data[0], 7);
+  g.addEdge(&data[4], &data[2], 6);
+  auto edges = gt::ShortestPathOneSource(&g, &data[0],
+                                         gt::ShortestPathAlgo::DIJKSTRA_RADIX);
+  assert(edges.size() == 4);
+  assert(totalWeight<std::string>(edges) == 11);
+
+  // small weights (Dial's buckets, zero weights included) and large weights
+  // (radix heap) against the binary heap version
+  for (int max_weight : {0, 3, 100, 1000000}) {
+    gt::DirectedGraph<int> rg;
+    std::vector<int> rdata;
+    randomGraph(rg, rdata, 400, 2000, max_weight, 17u + max_weight);
+    for (int s : {0, 7}) {
+      auto expected = treeDistances<int>(
+          gt::ShortestPathOneSource(&rg, &rdata[s], gt::DIJKSTRA), &rdata[s]);
+      auto radix = treeDistances<int>(
+          gt::ShortestPathOneSource(&rg, &rdata[s], gt::DIJKSTRA_RADIX),
+          &rdata[s]);
+      assert(radix == expected);
+    }
+  }
+
+  // negative weights are rejected without scanning the edges
+  g.addEdge(&data[2], &data[4], -1);
+  assert(gt::ShortestPathOneSource(&g, &data[0],
+                                   gt::ShortestPathAlgo::DIJKSTRA_RADIX)
+             .empty());
+  g.removeEdge(&data[2], &data[4]);
+  assert(gt::ShortestPathOneSource(&g, &data[0],
+                                   gt::ShortestPathAlgo::DIJKSTRA_RADIX)
+             .size() == 4);
+}
+
+// edges as comparable tuples
+std::vector<std::tuple<int *, int *, int>>
+edgeSet(const std::vector<gt::Graph<int>::Edge> &edges) {
+  std::vector<std::tuple<int *, int *, int>> res;
+  for (const auto &e : edges) {
+    res.push_back({e.from.get_data(), e.to.get_data(), e.weight_});
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+void test_delta_stepping() {
+  for (int max_weight : {0, 5, 1000, 1000000}) {
+    gt::DirectedGraph<int> g;
+    std::vector<int> data;
+    randomGraph(g, data, 2000, 10000, max_weight, 3u + max_weight);
+    auto expected = gt::ShortestPathOneSource(&g, &data[0], gt::DIJKSTRA);
+    auto radix = gt::ShortestPathOneSource(&g, &data[0], gt::DIJKSTRA_RADIX);
+    for (size_t threads : {1, 4}) {
+      auto delta = gt::ShortestPathOneSource(&g, &data[0], gt::DELTA_STEPPING,
+                                             threads);
+      assert(treeDistances<int>(delta, &data[0]) ==
+             treeDistances<int>(expected, &data[0]));
+      // both derive the tree from the distances
+      assert(edgeSet(delta) == edgeSet(radix));
+    }
+  }
+
+  // undirected graph on two threads
+  gt::UnDirectedGraph<int> ug;
+  std::vector<int> data(6);
+  for (int i = 0; i < 6; ++i) {
+    data[i] = i;
+  }
+  ug.addEdge(&data[0], &data[1], 7);
+  ug.addEdge(&data[0], &data[2], 9);
+  ug.addEdge(&data[0], &data[5], 14);
+  ug.addEdge(&data[1], &data[2], 10);
+  ug.addEdge(&data[1], &data[3], 15);
+  ug.addEdge(&data[2], &data[3], 11);
+  ug.addEdge(&data[2], &data[5], 2);
+  ug.addEdge(&data[3], &data[4], 6);
+  ug.addEdge(&data[4], &data[5], 9);
+  auto tree = gt::ShortestPathOneSource(&ug, &data[0], gt::DELTA_STEPPING, 2);
+  auto dist = treeDistances<int>(tree, &data[0]);
+  assert(dist.at(&data[4]) == 20);
+  assert(dist.at(&data[3]) == 20);
+  assert(dist.at(&data[5]) == 11);
+}
+
+// random digraph whose weights may be negative but whose cycles are not:
+// w(u, v) = c + p[u] - p[v] with c in [0, max_weight]
+void randomPotentialGraph(gt::DirectedGraph<int> &g, std::vector<int> &data,
+                          int n, int m, int max_weight, unsigned seed) {
+  data.resize(n);
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> pot(-50, 50);
+  std::vector<int> p(n);
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    p[i] = pot(rng);
+    g.addVertex(&data[i]);
+  }
+  std::uniform_int_distribution<int> pick(0, n - 1);
+  std::uniform_int_distribution<int> weight(0, max_weight);
+  for (int i = 0; i < m; ++i) {
+    const int u = pick(rng);
+    const int v = pick(rng);
+    g.addEdge(&data[u], &data[v], weight(rng) + p[u] - p[v]);
+  }
+}
+
+void test_johnson() {
+  for (int max_weight : {0, 20}) {
+    gt::DirectedGraph<int> g;
+    std::vector<int> data;
+    randomPotentialGraph(g, data, 60, 300, max_weight, 5u + max_weight);
+    assert(g.hasNegativeWeight());
+    auto floyd = gt::ShortestPathAllPairs(&g, gt::FLOYD_WARSHALL);
+    auto johnson = gt::ShortestPathAllPairs(&g, gt::JOHNSON, 1);
+    auto johnson4 = gt::ShortestPathAllPairs(&g, gt::JOHNSON, 4);
+    assert(johnson.size() == data.size());
+    gt::JohnsonShortestPaths<int> index(&g);
+    assert(index.valid());
+    for (int &s : data) {
+      const auto expected = treeDistances<int>(floyd[&s], &s);
+      assert(treeDistances<int>(johnson[&s], &s) == expected);
+      assert(edgeSet(johnson4[&s]) == edgeSet(johnson[&s]));
+      assert(edgeSet(index.oneSource(&s)) == edgeSet(johnson[&s]));
+      assert(edgeSet(gt::ShortestPathOneSource(&g, &s, gt::JOHNSON)) ==
+             edgeSet(johnson[&s]));
+    }
+  }
+
+  // without negative weights the potentials stay 0
+  gt::DirectedGraph<int> g;
+  std::vector<int> data;
+  randomGraph(g, data, 300, 1500, 100, 11u);
+  gt::JohnsonShortestPaths<int> index(&g);
+  assert(index.potential(&data[3]) == 0);
+  assert(edgeSet(index.oneSource(&data[0])) ==
+         edgeSet(gt::ShortestPathOneSource(&g, &data[0], gt::DIJKSTRA_RADIX)));
+
+  // negative cycle
+  g.addEdge(&data[1], &data[2], -1000);
+  g.addEdge(&data[2], &data[1], -1000);
+  assert(!index.build(&g));
+  assert(index.oneSource(&data[0]).empty());
+  assert(gt::ShortestPathAllPairs(&g, gt::JOHNSON).empty());
+  assert(gt::ShortestPathOneSource(&g, &data[0], gt::JOHNSON).empty());
+}
+
+void test_floyd_warshall_blocked() {
+  // several tiles plus a partial one, sparse enough to leave vertexs
+  // unreachable; small weights use int distances, large ones long long
+  for (int max_weight : {10, 10000000}) {
+    gt::DirectedGraph<int> g;
+    std::vector<int> data;
+    randomPotentialGraph(g, data, 150, 300, max_weight, 9u + max_weight);
+    auto johnson = gt::ShortestPathAllPairs(&g, gt::JOHNSON);
+    auto floyd = gt::ShortestPathAllPairs(&g, gt::FLOYD_WARSHALL, 1);
+    auto floyd4 = gt::ShortestPathAllPairs(&g, gt::FLOYD_WARSHALL, 4);
+    assert(floyd.size() == data.size());
+    for (int &s : data) {
+      assert(treeDistances<int>(floyd[&s], &s) ==
+             treeDistances<int>(johnson[&s], &s));
+      assert(edgeSet(floyd4[&s]) == edgeSet(floyd[&s]));
+    }
+  }
+
+  // a negative cycle among the tiles
+  gt::DirectedGraph<int> g;
+  std::vector<int> data;
+  randomPotentialGraph(g, data, 150, 600, 10, 4u);
+  g.addEdge(&data[140], &data[141], -500);
+  g.addEdge(&data[141], &data[140], -500);
+  assert(gt::ShortestPathAllPairs(&g, gt::FLOYD_WARSHALL).empty());
+}
+
+// a negative cycle: consecutive edges, total weight below 0
+void checkNegativeCycle(const std::vector<gt::Graph<int>::Edge> &cycle) {
+  assert(!cycle.empty());
+  long long total = 0;
+  for (size_t i = 0; i < cycle.size(); ++i) {
+    const auto &next = cycle[(i + 1) % cycle.size()];
+    assert(cycle[i].to.get_data() == next.from.get_data());
+    total += cycle[i].weight_;
+  }
+  assert(total < 0);
+}
+
+void test_spfa() {
+  vector<std::string> sdata = {"S", "A", "B", "C", "D"};
+  gt::DirectedGraph<std::string> sg;
+  sg.addEdge(&sdata[0], &sdata[1], 6);
+  sg.addEdge(&sdata[0], &sdata[3], 7);
+  sg.addEdge(&sdata[1], &sdata[2], 5);
+  sg.addEdge(&sdata[1], &sdata[3], 8);
+  sg.addEdge(&sdata[1], &sdata[4], -4);
+  sg.addEdge(&sdata[2], &sdata[1], -2);
+  sg.addEdge(&sdata[3], &sdata[2], -3);
+  sg.addEdge(&sdata[3], &sdata[4], 9);
+  sg.addEdge(&sdata[4], &sdata[0], 2);
+  sg.addEdge(&sdata[4], &sdata[2], 7);
+  auto tree = gt::ShortestPathOneSource(&sg, &sdata[0], gt::SPFA);
+  auto dist = treeDistances<std::string>(tree, &sdata[0]);
+  assert(tree.size() == 4);
+  assert(dist.at(&sdata[1]) == 2);
+  assert(dist.at(&sdata[2]) == 4);
+  assert(dist.at(&sdata[3]) == 7);
+  assert(dist.at(&sdata[4]) == -2);
+  assert(gt::FindNegativeCycle(&sg, &sdata[0]).empty());
+
+  for (int max_weight : {0, 20}) {
+    gt::DirectedGraph<int> g;
+    std::vector<int> data;
+    randomPotentialGraph(g, data, 300, 1500, max_weight, 21u + max_weight);
+    for (int s : {0, 5}) {
+      auto expected = treeDistances<int>(
+          gt::ShortestPathOneSource(&g, &data[s], gt::BELLMAN_FORD),
+          &data[s]);
+      assert(treeDistances<int>(
+                 gt::ShortestPathOneSource(&g, &data[s], gt::SPFA),
+                 &data[s]) == expected);
+    }
+    assert(gt::FindNegativeCycle<int>(&g).empty());
+
+    // close a negative cycle through a long path
+    g.addEdge(&data[7], &data[8], -2000);
+    g.addEdge(&data[8], &data[9], 1);
+    g.addEdge(&data[9], &data[7], 1);
+    assert(gt::ShortestPathOneSource(&g, &data[0], gt::SPFA).empty());
+    checkNegativeCycle(gt::FindNegativeCycle<int>(&g));
+  }
+
+  // unreachable from the source, found without one
+  gt::DirectedGraph<int> g;
+  std::vector<int> data(5);
+  for (int i = 0; i < 5; ++i) {
+    data[i] = i;
+  }
+  g.addEdge(&data[0], &data[1], 1);
+  g.addEdge(&data[2], &data[3], 2);
+  g.addEdge(&data[3], &data[4], -1);
+  g.addEdge(&data[4], &data[2], -2);
+  assert(gt::ShortestPathOneSource(&g, &data[0], gt::SPFA).size() == 1);
+  assert(gt::FindNegativeCycle(&g, &data[0]).empty());
+  auto cycle = gt::FindNegativeCycle<int>(&g);
+  checkNegativeCycle(cycle);
+  assert(cycle.size() == 3);
+
+  // a negative undirected edge is walked both ways
+  gt::UnDirectedGraph<int> ug;
+  ug.addEdge(&data[0], &data[1], 3);
+  ug.addEdge(&data[1], &data[2], -1);
+  checkNegativeCycle(gt::FindNegativeCycle(&ug, &data[0]));
+}
+
+void test_bellman_ford_parallel() {
+  for (int max_weight : {0, 20, 100000}) {
+    gt::DirectedGraph<int> g;
+    std::vector<int> data;
+    randomPotentialGraph(g, data, 500, 3000, max_weight, 31u + max_weight);
+    auto expected = treeDistances<int>(
+        gt::ShortestPathOneSource(&g, &data[0], gt::SPFA), &data[0]);
+    auto one = gt::ShortestPathOneSource(&g, &data[0],
+                                         gt::BELLMAN_FORD_PARALLEL, 1);
+    auto four = gt::ShortestPathOneSource(&g, &data[0],
+                                          gt::BELLMAN_FORD_PARALLEL, 4);
+    assert(treeDistances<int>(one, &data[0]) == expected);
+    assert(edgeSet(four) == edgeSet(one));
+
+    g.addEdge(&data[10], &data[11], -300000);
+    g.addEdge(&data[11], &data[10], 1);
+    g.addEdge(&data[0], &data[10], 0);
+    assert(gt::ShortestPathOneSource(&g, &data[0], gt::BELLMAN_FORD_PARALLEL,
+                                     4)
+               .empty());
+  }
+}
+
+// edges of an s-t path chain up and add up to its cost
+template <typename T>
+void checkPath(const gt::ShortestPathResult<T> &res, T *s, T *t) {
+  assert(res.found);
+  long long total = 0;
+  T *at = s;
+  for (const auto &e : res.edges) {
+    assert(e.from.get_data() == at);
+    at = e.to.get_data();
+    total += e.weight_;
+  }
+  assert(at == t);
+  assert(total == res.cost);
+}
+
+void test_bidirectional_dijkstra() {
+  for (int max_weight : {0, 5, 1000}) {
+    gt::DirectedGraph<int> g;
+    std::vector<int> data;
+    randomGraph(g, data, 1000, 4000, max_weight, 41u + max_weight);
+    auto dist = treeDistances<int>(
+        gt::ShortestPathOneSource(&g, &data[0], gt::DIJKSTRA_RADIX),
+        &data[0]);
+    for (int t = 0; t < 1000; t += 7) {
+      auto res = gt::ShortestPath(&g, &data[0], &data[t]);
+      auto it = dist.find(&data[t]);
+      if (it == dist.end()) {
+        assert(!res.found && res.edges.empty());
+        continue;
+      }
+      checkPath(res, &data[0], &data[t]);
+      assert(res.cost == it->second);
+    }
+  }
+
+  // a 200 x 200 grid: a short query settles a small part of it
+  const int side = 200;
+  gt::UnDirectedGraph<int> grid;
+  std::vector<int> cells(side * side);
+  for (int i = 0; i < side * side; ++i) {
+    cells[i] = i;
+  }
+  for (int r = 0; r < side; ++r) {
+    for (int c = 0; c < side; ++c) {
+      if (c + 1 < side) {
+        grid.addEdge(&cells[r * side + c], &cells[r * side + c + 1], 1);
+      }
+      if (r + 1 < side) {
+        grid.addEdge(&cells[r * side + c], &cells[(r + 1) * side + c], 1);
+      }
+    }
+  }
+  int *s = &cells[100 * side + 100];
+  int *t = &cells[103 * side + 104];
+  auto res = gt::ShortestPath(&grid, s, t);
+  checkPath(res, s, t);
+  assert(res.cost == 7);
+  assert(res.settled < cells.size() / 100);
+
+  auto same = gt::ShortestPath(&grid, s, s);
+  assert(same.found && same.cost == 0 && same.edges.empty());
+
+  // unreachable and unknown targets, negative weights
+  gt::DirectedGraph<int> dg;
+  std::vector<int> data = {0, 1, 2, 3};
+  dg.addEdge(&data[0], &data[1], 4);
+  dg.addEdge(&data[2], &data[1], 1);
+  assert(!gt::ShortestPath(&dg, &data[0], &data[2]).found);
+  assert(!gt::ShortestPath(&dg, &data[0], &data[3]).found);
+  dg.addEdge(&data[1], &data[2], -1);
+  assert(!gt::ShortestPath(&dg, &data[0], &data[2]).found);
+}
+
 void test_k_shortest_path_astar() {
   std::vector<std::string> data = {"A", "B", "C", "D"};
   gt::DirectedGraph<std::string> g;
@@ -121,6 +526,13 @@ int main() {
   test_bellman_ford();
   test_bellman_ford_negative_cycle();
   test_floyd_warshall();
+  test_dijkstra_radix();
+  test_delta_stepping();
+  test_johnson();
+  test_floyd_warshall_blocked();
+  test_spfa();
+  test_bellman_ford_parallel();
+  test_bidirectional_dijkstra();
   test_k_shortest_path_astar();
   std::cout << "All shortest path tests passed!" << std::endl;
   return 0;
@@ -0,0 +1,100 @@
+#include "graph.hpp"
+#include "graph_reachability.hpp"
+#include "graph_transitive_closure.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace gt = graphTest;
+
+#define TEST_AND_RUN(test_name)                                                \
+  std::cout << "Running " << #test_name << "..." << std::endl;                 \
+  test_name();                                                                 \
+  std::cout << #test_name << " passed!" << std::endl;
+
+void test_closure_small() {
+  std::vector<std::string> data = {"A", "B", "C", "D", "E"};
+  /*
+  graph
+      A --> B --> C --> A
+      C --> D
+      E
+  */
+  gt::DirectedGraph<std::string> g;
+  g.addEdge(&data[0], &data[1]);
+  g.addEdge(&data[1], &data[2]);
+  g.addEdge(&data[2], &data[0]);
+  g.addEdge(&data[2], &data[3]);
+  g.addVertex(&data[4]);
+
+  gt::TransitiveClosure<std::string> tc;
+  assert(tc.build(&g));
+  assert(tc.numComponents() == 3);
+  assert(tc.reaches(&data[0], &data[0]));
+  assert(tc.reaches(&data[1], &data[0]));
+  assert(tc.reaches(&data[0], &data[3]));
+  assert(!tc.reaches(&data[3], &data[0]));
+  assert(!tc.reaches(&data[4], &data[0]));
+  assert(!tc.reaches(&data[0], &data[4]));
+
+  auto from_b = tc.reachableFrom(&data[1]);
+  std::sort(from_b.begin(), from_b.end());
+  std::vector<std::string *> expected = {&data[0], &data[1], &data[2],
+                                         &data[3]};
+  std::sort(expected.begin(), expected.end());
+  assert(from_b == expected);
+}
+
+void test_closure_memory_limit() {
+  std::vector<int> data(200);
+  gt::DirectedGraph<int> g;
+  for (int i = 0; i + 1 < 200; ++i) {
+    data[i] = i;
+    g.addEdge(&data[i], &data[i + 1]);
+  }
+  // 200 components -> 4 words per row
+  assert(gt::TransitiveClosure<int>::estimateMemoryBytes(&g) == 200 * 4 * 8);
+  gt::TransitiveClosure<int> tc;
+  assert(!tc.build(&g, 1024));
+  assert(tc.empty());
+  assert(tc.build(&g));
+  assert(tc.memoryBytes() == 200 * 4 * 8);
+  assert(tc.reaches(&data[0], &data[199]));
+  assert(!tc.reaches(&data[199], &data[0]));
+}
+
+void test_closure_random() {
+  const int n = 150;
+  std::vector<int> data(n);
+  gt::DirectedGraph<int> g;
+  std::mt19937 rng(7);
+  for (int i = 0; i < n; ++i) {
+    data[i] = i;
+    g.addVertex(&data[i]);
+  }
+  for (int k = 0; k < 2 * n; ++k) {
+    int u = rng() % n;
+    int v = rng() % n;
+    if (u != v) {
+      g.addEdge(&data[u], &data[v]);
+    }
+  }
+  gt::TransitiveClosure<int> tc;
+  assert(tc.build(&g));
+  for (int s = 0; s < n; ++s) {
+    for (int t = 0; t < n; ++t) {
+      assert(tc.reaches(&data[s], &data[t]) ==
+             gt::isReachable(&g, &data[s], &data[t]));
+    }
+  }
+}
+
+int main() {
+  TEST_AND_RUN(test_closure_small);
+  TEST_AND_RUN(test_closure_memory_limit);
+  TEST_AND_RUN(test_closure_random);
+  return 0;
+}